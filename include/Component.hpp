@@ -14,6 +14,8 @@ public:
     virtual void Render(SDL_Renderer *renderer) {}
     virtual ComponentType GetType() const = 0;
 
-    virtual void SetGameEntity(std::shared_ptr<GameEntity> entity) {}
-    virtual std::shared_ptr<GameEntity> GetGameEntity() const { return nullptr; }
+    // The owning entity is a non-owning back reference: the entity owns its
+    // components, never the other way round.
+    virtual void SetGameEntity(GameEntity *entity) {}
+    virtual GameEntity *GetGameEntity() const { return nullptr; }
 };
@@ -6,4 +6,6 @@
 enum class ComponentType : short {TextureComponent,
                                   TransformComponent,
                                   Collision2DComponent,
-                                  InputComponent};
\ No newline at end of file
+                                  InputComponent,
+                                  // Number of component types; sizes the per-entity slot array.
+                                  Count};
\ No newline at end of file
@@ -0,0 +1,260 @@
+#include "AABBBatch.h"
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define AABB_HAS_SSE2 1
+#endif
+
+// The AVX2 kernel is compiled for its own target and only selected when the CPU has it,
+// so the rest of the program does not need to be built with -mavx2.
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define AABB_HAS_AVX2 1
+#endif
+
+/**
+ * @brief Empties the batch.
+ */
+void AABBBatch::Clear()
+{
+    mMinX.clear();
+    mMinY.clear();
+    mMaxX.clear();
+    mMaxY.clear();
+}
+
+/**
+ * @brief Reserves room for a number of boxes.
+ *
+ * @param count The number of boxes to reserve space for.
+ */
+void AABBBatch::Reserve(size_t count)
+{
+    mMinX.reserve(count);
+    mMinY.reserve(count);
+    mMaxX.reserve(count);
+    mMaxY.reserve(count);
+}
+
+/**
+ * @brief Appends a box.
+ *
+ * @param rect The box as a position and size.
+ */
+void AABBBatch::Push(const SDL_FRect &rect)
+{
+    mMinX.push_back(rect.x);
+    mMinY.push_back(rect.y);
+    mMaxX.push_back(rect.x + rect.w);
+    mMaxY.push_back(rect.y + rect.h);
+}
+
+/**
+ * @brief Replaces the batch with boxes given as position and size arrays.
+ *
+ * Suits the dense arrays of an ArchetypeStorage.
+ *
+ * @param x The left edges.
+ * @param y The top edges.
+ * @param w The widths.
+ * @param h The heights.
+ * @param count The number of boxes in each array.
+ */
+void AABBBatch::Assign(const float *x, const float *y, const float *w, const float *h, size_t count)
+{
+    mMinX.assign(x, x + count);
+    mMinY.assign(y, y + count);
+    mMaxX.resize(count);
+    mMaxY.resize(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        mMaxX[i] = x[i] + w[i];
+        mMaxY[i] = y[i] + h[i];
+    }
+}
+
+namespace
+{
+    /**
+     * @brief Tests boxes [begin, end) of the batch one at a time.
+     *
+     * Two boxes overlap when, on both axes, the larger of their minimums is below the smaller
+     * of their maximums. That is the test SDL_HasIntersectionF() makes, so empty boxes never
+     * overlap anything and boxes that only share an edge do not overlap.
+     */
+    size_t OverlapScalar(const SDL_FRect &box, const AABBBatch &batch, size_t begin, size_t end, uint32_t *out, size_t count)
+    {
+        const float minX = box.x, minY = box.y, maxX = box.x + box.w, maxY = box.y + box.h;
+        const float *bMinX = batch.MinX(), *bMinY = batch.MinY(), *bMaxX = batch.MaxX(), *bMaxY = batch.MaxY();
+        for (size_t i = begin; i < end; ++i)
+        {
+            const bool overlap = std::max(minX, bMinX[i]) < std::min(maxX, bMaxX[i]) &&
+                                 std::max(minY, bMinY[i]) < std::min(maxY, bMaxY[i]);
+            out[count] = static_cast<uint32_t>(i);
+            count += overlap;
+        }
+        return count;
+    }
+
+#ifdef AABB_HAS_SSE2
+    /**
+     * @brief Tests the batch four boxes per instruction with SSE2.
+     */
+    size_t OverlapSSE2(const SDL_FRect &box, const AABBBatch &batch, uint32_t *out)
+    {
+        const __m128 minX = _mm_set1_ps(box.x), minY = _mm_set1_ps(box.y);
+        const __m128 maxX = _mm_set1_ps(box.x + box.w), maxY = _mm_set1_ps(box.y + box.h);
+        const size_t size = batch.Size();
+        size_t count = 0;
+        size_t i = 0;
+        for (; i + 4 <= size; i += 4)
+        {
+            const __m128 lowX = _mm_max_ps(minX, _mm_loadu_ps(batch.MinX() + i));
+            const __m128 highX = _mm_min_ps(maxX, _mm_loadu_ps(batch.MaxX() + i));
+            const __m128 lowY = _mm_max_ps(minY, _mm_loadu_ps(batch.MinY() + i));
+            const __m128 highY = _mm_min_ps(maxY, _mm_loadu_ps(batch.MaxY() + i));
+            const __m128 overlap = _mm_and_ps(_mm_cmplt_ps(lowX, highX), _mm_cmplt_ps(lowY, highY));
+            int mask = _mm_movemask_ps(overlap);
+            for (uint32_t lane = 0; mask; ++lane, mask >>= 1)
+            {
+                out[count] = static_cast<uint32_t>(i) + lane;
+                count += mask & 1;
+            }
+        }
+        return OverlapScalar(box, batch, i, size, out, count);
+    }
+#endif
+
+#ifdef AABB_HAS_AVX2
+    /**
+     * @brief Tests the batch eight boxes per instruction with AVX2.
+     */
+    __attribute__((target("avx2"))) size_t OverlapAVX2(const SDL_FRect &box, const AABBBatch &batch, uint32_t *out)
+    {
+        const __m256 minX = _mm256_set1_ps(box.x), minY = _mm256_set1_ps(box.y);
+        const __m256 maxX = _mm256_set1_ps(box.x + box.w), maxY = _mm256_set1_ps(box.y + box.h);
+        const size_t size = batch.Size();
+        size_t count = 0;
+        size_t i = 0;
+        for (; i + 8 <= size; i += 8)
+        {
+            const __m256 lowX = _mm256_max_ps(minX, _mm256_loadu_ps(batch.MinX() + i));
+            const __m256 highX = _mm256_min_ps(maxX, _mm256_loadu_ps(batch.MaxX() + i));
+            const __m256 lowY = _mm256_max_ps(minY, _mm256_loadu_ps(batch.MinY() + i));
+            const __m256 highY = _mm256_min_ps(maxY, _mm256_loadu_ps(batch.MaxY() + i));
+            const __m256 overlap = _mm256_and_ps(_mm256_cmp_ps(lowX, highX, _CMP_LT_OQ), _mm256_cmp_ps(lowY, highY, _CMP_LT_OQ));
+            for (unsigned mask = static_cast<unsigned>(_mm256_movemask_ps(overlap)); mask; mask &= mask - 1)
+                out[count++] = static_cast<uint32_t>(i) + static_cast<uint32_t>(__builtin_ctz(mask));
+        }
+        return OverlapScalar(box, batch, i, size, out, count);
+    }
+#endif
+}
+
+/**
+ * @brief Finds the boxes of a batch that overlap a rectangle, using the best kernel the CPU supports.
+ *
+ * @param box The rectangle to test, e.g. a paddle's collision rectangle.
+ * @param batch The boxes to test it against.
+ * @param out Receives the indices of the overlapping boxes in ascending order; must have room for batch.Size() entries.
+ * @return size_t The number of overlapping boxes written to out.
+ */
+size_t OverlapBatch(const SDL_FRect &box, const AABBBatch &batch, uint32_t *out)
+{
+    static const AABBKernel kernel = BestAABBKernel();
+    return OverlapBatch(box, batch, out, kernel);
+}
+
+/**
+ * @brief Finds the boxes of a batch that overlap a rectangle, using a given kernel.
+ *
+ * Every kernel returns exactly what calling SDL_HasIntersectionF() on each box would.
+ * An unsupported kernel falls back to the scalar one.
+ *
+ * @param box The rectangle to test.
+ * @param batch The boxes to test it against.
+ * @param out Receives the indices of the overlapping boxes in ascending order; must have room for batch.Size() entries.
+ * @param kernel The instruction set to use.
+ * @return size_t The number of overlapping boxes written to out.
+ */
+size_t OverlapBatch(const SDL_FRect &box, const AABBBatch &batch, uint32_t *out, AABBKernel kernel)
+{
+    if (!IsAABBKernelSupported(kernel))
+        kernel = AABBKernel::Scalar;
+    switch (kernel)
+    {
+#ifdef AABB_HAS_AVX2
+    case AABBKernel::AVX2:
+        return OverlapAVX2(box, batch, out);
+#endif
+#ifdef AABB_HAS_SSE2
+    case AABBKernel::SSE2:
+        return OverlapSSE2(box, batch, out);
+#endif
+    default:
+        return OverlapScalar(box, batch, 0, batch.Size(), out, 0);
+    }
+}
+
+/**
+ * @brief Returns the widest kernel the running CPU supports.
+ *
+ * @return AABBKernel The kernel OverlapBatch() uses by default.
+ */
+AABBKernel BestAABBKernel()
+{
+    if (IsAABBKernelSupported(AABBKernel::AVX2))
+        return AABBKernel::AVX2;
+    if (IsAABBKernelSupported(AABBKernel::SSE2))
+        return AABBKernel::SSE2;
+    return AABBKernel::Scalar;
+}
+
+/**
+ * @brief Checks whether a kernel was compiled in and the running CPU can execute it.
+ *
+ * @param kernel The kernel to check.
+ * @return bool True if OverlapBatch() can use the kernel.
+ */
+bool IsAABBKernelSupported(AABBKernel kernel)
+{
+    switch (kernel)
+    {
+    case AABBKernel::Scalar:
+        return true;
+    case AABBKernel::SSE2:
+#ifdef AABB_HAS_SSE2
+        return true;
+#else
+        return false;
+#endif
+    case AABBKernel::AVX2:
+#ifdef AABB_HAS_AVX2
+        return __builtin_cpu_supports("avx2");
+#else
+        return false;
+#endif
+    }
+    return false;
+}
+
+/**
+ * @brief Returns a kernel's display name.
+ *
+ * @param kernel The kernel.
+ * @return const char* The name, e.g. "SSE2".
+ */
+const char *AABBKernelName(AABBKernel kernel)
+{
+    switch (kernel)
+    {
+    case AABBKernel::Scalar:
+        return "scalar";
+    case AABBKernel::SSE2:
+        return "SSE2";
+    case AABBKernel::AVX2:
+        return "AVX2";
+    }
+    return "unknown";
+}
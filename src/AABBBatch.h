@@ -0,0 +1,70 @@
+#ifndef AABBBATCH_H
+#define AABBBATCH_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <SDL2/SDL.h>
+
+/**
+ * @brief The instruction sets OverlapBatch() can test rectangles with.
+ */
+enum class AABBKernel
+{
+    Scalar, ///< One rectangle at a time, portable C++.
+    SSE2,   ///< Four rectangles per instruction.
+    AVX2    ///< Eight rectangles per instruction.
+};
+
+/**
+ * @brief The AABBBatch class stores axis-aligned boxes as separate min/max arrays.
+ *
+ * Keeping each bound in its own contiguous array (structure of arrays) lets OverlapBatch()
+ * load the same bound of several boxes with one vector instruction.
+ */
+class AABBBatch
+{
+public:
+    void Clear();
+    void Reserve(size_t count);
+    void Push(const SDL_FRect &rect);
+    void Assign(const float *x, const float *y, const float *w, const float *h, size_t count);
+
+    /**
+     * @brief Returns the number of boxes in the batch.
+     *
+     * @return size_t The box count.
+     */
+    size_t Size() const { return mMinX.size(); }
+
+    /**
+     * @brief Returns the left edges of the boxes, Size() floats.
+     */
+    const float *MinX() const { return mMinX.data(); }
+
+    /**
+     * @brief Returns the top edges of the boxes, Size() floats.
+     */
+    const float *MinY() const { return mMinY.data(); }
+
+    /**
+     * @brief Returns the right edges (x + w) of the boxes, Size() floats.
+     */
+    const float *MaxX() const { return mMaxX.data(); }
+
+    /**
+     * @brief Returns the bottom edges (y + h) of the boxes, Size() floats.
+     */
+    const float *MaxY() const { return mMaxY.data(); }
+
+private:
+    std::vector<float> mMinX, mMinY, mMaxX, mMaxY;
+};
+
+size_t OverlapBatch(const SDL_FRect &box, const AABBBatch &batch, uint32_t *out);
+size_t OverlapBatch(const SDL_FRect &box, const AABBBatch &batch, uint32_t *out, AABBKernel kernel);
+AABBKernel BestAABBKernel();
+bool IsAABBKernelSupported(AABBKernel kernel);
+const char *AABBKernelName(AABBKernel kernel);
+
+#endif
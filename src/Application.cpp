@@ -1,17 +1,30 @@
 #include "Application.h"
 #include "Scene.h"
+#include "ResourceManager.h"
+#include "FramePacer.h"
+#include "Profiler.h"
+#include "InputComponent.h"
 #include <iostream>
+#include <cmath>
+#include <algorithm>
 #include <SDL2/SDL.h>
 
 /**
  * @brief Constructs a new Application object.
+ *
+ * @param timing Simulation rate, frame rate and catch-up cap of the main loop.
  */
-Application::Application()
+Application::Application(const LoopTiming &timing)
     : mWindow(nullptr),
       mRenderer(nullptr),
       mRun(true),
       mWindowWidth(1600),
       mWindowHeight(1000),
+      mTiming(timing),
+      mTracePath("profile.json"),
+      mSeed(0),
+      mHotReloadEnabled(false),
+      mScenePaths{"../Scenes/scene1.txt", "../Scenes/scene2.txt", "../Scenes/scene3.txt"},
       mCurrentSceneIndex(0)
 {
 }
@@ -19,10 +32,22 @@ Application::Application()
 /**
  * @brief Destroys the Application object.
  *
- * This destructor cleans up the SDL renderer and window, then quits SDL.
+ * This destructor writes the profiler trace (when profiling is compiled in) and the input log
+ * (when recording), stops the file watcher and the scene
+ * streamer, releases the scenes and the cached textures, then cleans up the SDL renderer and
+ * window, and quits SDL.
  */
 Application::~Application()
 {
+    if (Profiler::kEnabled)
+        Profiler::WriteChromeTrace(mTracePath);
+    if (!mRecordPath.empty() && mInputLog.Save(mRecordPath))
+        std::cout << "Recorded " << mInputLog.GetStepCount() << " steps to " << mRecordPath << std::endl;
+    mHotReload.reset();
+    mStreamer.reset();
+    mScene.reset();
+    mJobs.reset();
+    ResourceManager::getInstance().Clear();
     if (mRenderer)
         SDL_DestroyRenderer(mRenderer);
     if (mWindow)
@@ -33,7 +58,9 @@ Application::~Application()
 /**
  * @brief Initializes the application.
  *
- * Initializes SDL, creates a window and renderer, and loads the scenes from file.
+ * Initializes SDL, creates a window and renderer, starts the job system, the scene streamer
+ * and, if enabled, the hot reload watcher, and waits for the first scene only; the second
+ * then starts loading in the background.
  *
  * @return true if initialization is successful, false otherwise.
  */
@@ -63,31 +90,50 @@ bool Application::init()
         return false;
     }
 
-    // Load scene1 from file
-    std::unique_ptr<Scene> scene1 = std::make_unique<Scene>();
-    scene1->LoadFromFile("../Scenes/scene1.txt", mRenderer);
-    mScenes.push_back(std::move(scene1));
-    // Load scene2 from file
-    std::unique_ptr<Scene> scene2 = std::make_unique<Scene>();
-    scene2->LoadFromFile("../Scenes/scene2.txt", mRenderer);
-    mScenes.push_back(std::move(scene2));
-    // Load scene3 from file
-    std::unique_ptr<Scene> scene3 = std::make_unique<Scene>();
-    scene3->LoadFromFile("../Scenes/scene3.txt", mRenderer);
-    mScenes.push_back(std::move(scene3));
-
-    mCurrentSceneIndex = 0;
+    // Pack every sprite into one texture so a frame can be drawn in a few batches
+    if (!ResourceManager::getInstance().BuildAtlas(SpriteAssetPaths(), mRenderer))
+        std::cerr << "Texture atlas unavailable, using one texture per sprite" << std::endl;
+
+    mJobs = std::make_unique<JobSystem>(JobSystem::DefaultThreadCount());
+
+    std::cout << "Seed: " << mSeed << std::endl;
+    if (!mRecordPath.empty())
+        mInputLog.Begin(mSeed, static_cast<float>(1.0 / mTiming.simulationRate), mScenePaths);
+
+    if (mHotReloadEnabled)
+    {
+        mHotReload = std::make_unique<HotReloader>();
+        if (!mHotReload->Start(mScenePaths, SpriteAssetPaths()))
+            mHotReload.reset();
+    }
+
+    mStreamer = std::make_unique<SceneStreamer>(mJobs.get());
+    if (!mScenePaths.empty())
+        mStreamer->Request(mScenePaths[0]);
+
+    const Uint64 start = SDL_GetPerformanceCounter();
+    if (!enterScene(0))
+    {
+        std::cerr << "No scene to play" << std::endl;
+        return false;
+    }
+    std::cout << "First scene ready in "
+              << 1000.0 * static_cast<double>(SDL_GetPerformanceCounter() - start) / static_cast<double>(SDL_GetPerformanceFrequency())
+              << " ms" << std::endl;
 
     return true;
 }
 
 /**
- * @brief Processes input events and passes them to the current scene.
+ * @brief Processes window events.
  *
- * @param deltaTime Time elapsed since last frame, in seconds.
+ * Keyboard state is sampled by the scene on every simulation step, see update().
+ * F9 writes the profiler trace so far. When the renderer reports that render-target contents
+ * were lost, the scene's cached layers are redrawn on the next frame.
  */
-void Application::processInput(float deltaTime)
+void Application::processInput()
 {
+    PROFILE_ZONE("Application::processInput");
     SDL_Event event;
     while (SDL_PollEvent(&event))
     {
@@ -95,37 +141,144 @@ void Application::processInput(float deltaTime)
         {
             mRun = false;
         }
+        else if (event.type == SDL_KEYDOWN && event.key.keysym.sym == SDLK_F9 && Profiler::kEnabled)
+        {
+            Profiler::WriteChromeTrace(mTracePath);
+        }
+        else if (event.type == SDL_RENDER_TARGETS_RESET && mScene)
+        {
+            mScene->InvalidateRenderTargets();
+        }
     }
+}
+
+/**
+ * @brief Makes a streamed scene the current one.
+ *
+ * Takes the scene from the streamer (waiting if it is still loading), uploads its textures,
+ * seeds it from the run's seed and its index (as a replay does, see InputLog), brings it up
+ * to date with any hot-reloaded version of its file,
+ * hands the previous scene to the streamer to release, and requests the scene after it.
+ *
+ * @param index The scene's position in the scene list; it must be the next one requested.
+ * @return bool False if there is no such scene.
+ */
+bool Application::enterScene(size_t index)
+{
+    PROFILE_ZONE("Application::enterScene");
+    if (index >= mScenePaths.size())
+        return false;
 
-    if (!mScenes.empty())
+    if (index > 0 && !mStreamer->IsReady())
+        std::cout << "Waiting for " << mScenePaths[index] << " to finish loading" << std::endl;
+    std::unique_ptr<Scene> next = mStreamer->Take();
+    if (!next)
+        return false;
+    next->AttachRenderer(mRenderer);
+    next->SetSeed(MixSeed(mSeed, index));
+    for (const SceneEdit &edit : mSceneEdits)
     {
-        mScenes[mCurrentSceneIndex]->Input(deltaTime);
+        // The streamer may have loaded the file before its latest save.
+        if (edit.path == mScenePaths[index])
+        {
+            size_t added = 0, removed = 0;
+            next->ApplyBrickEdits(ViewScene(edit.records), added, removed);
+        }
     }
+
+    // The static brick layer is a texture of this thread's renderer; free it before the
+    // streamer's thread destroys the scene.
+    if (mScene)
+        mScene->ReleaseRenderTargets();
+    mStreamer->Retire(std::move(mScene));
+    mScene = std::move(next);
+    mCurrentSceneIndex = index;
+    if (index + 1 < mScenePaths.size())
+        mStreamer->Request(mScenePaths[index + 1]);
+    return true;
 }
 
 /**
- * @brief Updates the current scene.
+ * @brief Applies the files the hot reload watcher reloaded since the last frame.
  *
+ * Images are re-uploaded into their existing textures. Scene files are kept, so a scene
+ * streamed in later is patched too, and applied to the current scene if it is theirs.
+ */
+void Application::applyHotReload()
+{
+    PROFILE_ZONE("Application::applyHotReload");
+    std::vector<SceneEdit> scenes;
+    std::vector<ImageEdit> images;
+    mHotReload->Take(scenes, images);
+
+    for (const ImageEdit &image : images)
+    {
+        if (ResourceManager::getInstance().ReloadTexture(image.path, image.pixels))
+            std::cout << "Reloaded " << image.path << std::endl;
+    }
+
+    for (SceneEdit &edit : scenes)
+    {
+        if (mScene && edit.path == mScenePaths[mCurrentSceneIndex])
+            applySceneEdit(edit);
+        auto kept = std::find_if(mSceneEdits.begin(), mSceneEdits.end(), [&](const SceneEdit &other)
+                                 { return other.path == edit.path; });
+        if (kept != mSceneEdits.end())
+            *kept = std::move(edit);
+        else
+            mSceneEdits.push_back(std::move(edit));
+    }
+}
+
+/**
+ * @brief Adds and removes the current scene's bricks to match a reloaded version of its file.
+ *
+ * @param edit The reloaded scene file.
+ */
+void Application::applySceneEdit(const SceneEdit &edit)
+{
+    size_t added = 0, removed = 0;
+    mScene->ApplyBrickEdits(ViewScene(edit.records), added, removed);
+    std::cout << "Reloaded " << edit.path << ": " << added << " brick(s) added, " << removed << " removed" << std::endl;
+}
+
+/**
+ * @brief Advances the current scene by one simulation step.
+ *
+ * Saves the state to interpolate from, applies the keyboard's buttons, then updates the scene;
+ * when recording, the buttons and the resulting state hash are appended to the input log.
+ * If every ball was lost, shows the game over message and stops the loop.
  * If the current scene is ended, switches to the next scene if available,
  * or exits the application if there are no more scenes.
  *
- * @param deltaTime Time elapsed since last frame, in seconds.
+ * @param deltaTime The fixed step, in seconds.
  */
 void Application::update(float deltaTime)
 {
-    if (!mScenes.empty())
+    PROFILE_ZONE("Application::update");
+    if (mScene)
     {
-        mScenes[mCurrentSceneIndex]->Update(deltaTime);
-        if (!mScenes[mCurrentSceneIndex]->GetSceneStatus())
+        const uint8_t buttons = InputComponent::ReadKeyboard();
+        mScene->SaveRenderState();
+        mScene->Input(deltaTime, buttons);
+        mScene->Update(deltaTime);
+        if (!mRecordPath.empty())
+            mInputLog.Append(buttons, mScene->StateHash());
+        if (mScene->IsGameOver())
+        {
+            SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_INFORMATION, "GAME OVER", "GAME OVER! You Failed!", mWindow);
+            mRun = false;
+            return;
+        }
+        if (!mScene->GetSceneStatus())
         {
+            const SceneStats stats = mScene->GetStats();
             std::cout << "Current scene index: " << mCurrentSceneIndex
-                      << ", status: " << (mScenes[mCurrentSceneIndex]->GetSceneStatus() ? "active" : "ended")
+                      << ", status: " << (mScene->GetSceneStatus() ? "active" : "ended")
+                      << ", score: " << stats.score << " (" << stats.bricksBroken << " bricks, "
+                      << stats.dropsCaught << " drops caught, " << stats.ballsLost << " balls lost)"
                       << std::endl;
-            if (mCurrentSceneIndex + 1 < mScenes.size())
-            {
-                mCurrentSceneIndex++;
-            }
-            else
+            if (!enterScene(mCurrentSceneIndex + 1))
             {
                 mRun = false;
             }
@@ -135,45 +288,73 @@ void Application::update(float deltaTime)
 
 /**
  * @brief Renders the current scene.
+ *
+ * @param alpha How far the render time lies between the last two simulation steps, 0 to 1.
  */
-void Application::render()
+void Application::render(float alpha)
 {
+    PROFILE_ZONE("Application::render");
     SDL_SetRenderDrawColor(mRenderer, 0, 0, 0, 255);
     SDL_RenderClear(mRenderer);
 
-    if (!mScenes.empty())
+    if (mScene)
     {
-        mScenes[mCurrentSceneIndex]->Render(mRenderer);
+        mScene->Render(mRenderer, alpha);
     }
 
+    PROFILE_ZONE("SDL_RenderPresent");
     SDL_RenderPresent(mRenderer);
 }
 
 /**
  * @brief Runs the main game loop.
  *
- * The loop processes input, updates the game, and renders the scene at fixed frame rate.
+ * Elapsed real time, measured with SDL_GetPerformanceCounter, is accumulated and consumed in
+ * fixed simulation steps; at most maxStepsPerFrame steps run per frame and any excess is
+ * dropped, so a long stall slows the game down instead of freezing it in catch-up. Each frame
+ * is rendered between the last two steps and, when a frame rate is set, paced by a FramePacer.
  */
 void Application::run()
 {
-    const int targetFPS = 60;
-    const int frameDelay = 1000 / targetFPS;
-    Uint32 lastFrameTime = SDL_GetTicks();
+    const double step = 1.0 / mTiming.simulationRate;
+    const double frequency = static_cast<double>(SDL_GetPerformanceFrequency());
+    FramePacer pacer(mTiming.frameRate > 0.0 ? 1.0 / mTiming.frameRate : 0.0);
+
+    double accumulator = 0.0;
+    Uint64 previous = SDL_GetPerformanceCounter();
 
     while (mRun)
     {
-        Uint32 currentFrameTime = SDL_GetTicks();
-        float deltaTime = (currentFrameTime - lastFrameTime) / 1000.0f;
-        lastFrameTime = currentFrameTime;
+        PROFILE_ZONE("Frame");
+        Uint64 now = SDL_GetPerformanceCounter();
+        accumulator += static_cast<double>(now - previous) / frequency;
+        previous = now;
+
+        processInput();
+        if (mHotReload && mHotReload->HasChanges())
+            applyHotReload();
+
+        int steps = 0;
+        while (mRun && accumulator >= step)
+        {
+            if (steps == mTiming.maxStepsPerFrame)
+            {
+                accumulator = std::fmod(accumulator, step);
+                break;
+            }
+            update(static_cast<float>(step));
+            accumulator -= step;
+            steps++;
+        }
 
-        processInput(deltaTime);
-        update(deltaTime);
-        render();
+        if (!mRun)
+            break;
+        render(static_cast<float>(accumulator / step));
 
-        int frameTime = SDL_GetTicks() - currentFrameTime;
-        if (frameDelay > frameTime)
+        if (mTiming.frameRate > 0.0)
         {
-            SDL_Delay(frameDelay - frameTime);
+            PROFILE_ZONE("FramePacer::Wait");
+            pacer.Wait();
         }
     }
 }
@@ -4,35 +4,106 @@
 #include <SDL2/SDL.h>
 #include <vector>
 #include <memory>
+#include <string>
+#include <cstdint>
 #include "Scene.h"
+#include "JobSystem.h"
+#include "SceneStreamer.h"
+#include "InputLog.h"
+#include "HotReloader.h"
+
+/**
+ * @brief Timing parameters of the main loop.
+ */
+struct LoopTiming
+{
+    double simulationRate = 120.0; ///< Fixed simulation steps per second.
+    double frameRate = 60.0;       ///< Target rendered frames per second; 0 renders as fast as possible.
+    int maxStepsPerFrame = 8;      ///< Catch-up cap: simulation time beyond this many steps per frame is dropped.
+};
 
 /**
  * @brief The Application class encapsulates the entire game application.
  *
  * It manages SDL initialization, window and renderer creation, and the main game loop.
- * It also holds a vector of Scene objects and controls scene switching.
+ * It plays a list of scene files in order: only the current scene is resident while the
+ * next one is loaded in the background by a SceneStreamer, and a finished scene is released.
+ *
+ * The simulation advances in fixed steps of 1/simulationRate seconds, decoupled from the
+ * render rate; rendering interpolates between the last two simulated states.
  */
 class Application
 {
 public:
-    Application();
+    explicit Application(const LoopTiming &timing = LoopTiming());
     ~Application();
 
     bool init();
     void run();
 
+    /**
+     * @brief Sets where the profiler trace is written on F9 and on exit (BRICK_PROFILE builds only).
+     *
+     * @param path The Chrome trace JSON file.
+     */
+    void setTracePath(const std::string &path) { mTracePath = path; }
+
+    /**
+     * @brief Sets the scene files to play, in order. Must be called before init().
+     *
+     * @param scenePaths The scene files; defaults to scene1 to scene3.
+     */
+    void setScenes(const std::vector<std::string> &scenePaths) { mScenePaths = scenePaths; }
+
+    /**
+     * @brief Sets the seed the scenes' random generators are derived from. Must be called before init().
+     *
+     * @param seed The run's seed; the same seed and input replay the same game.
+     */
+    void setSeed(uint64_t seed) { mSeed = seed; }
+
+    /**
+     * @brief Records every step's input and state hash, written to a file on exit for --replay.
+     *
+     * @param path The input log file. Must be set before init().
+     */
+    void setRecordPath(const std::string &path) { mRecordPath = path; }
+
+    /**
+     * @brief Reloads scene files and sprite images as they are saved, see HotReloader. Must be called before init().
+     *
+     * Edits are not recorded, so a recording made while editing will not replay.
+     *
+     * @param enabled True to watch the files.
+     */
+    void setHotReload(bool enabled) { mHotReloadEnabled = enabled; }
+
 private:
-    void processInput(float deltaTime);
+    void processInput();
     void update(float deltaTime);
-    void render();
+    void render(float alpha);
+    bool enterScene(size_t index);
+    void applyHotReload();
+    void applySceneEdit(const SceneEdit &edit);
 
     SDL_Window *mWindow;
     SDL_Renderer *mRenderer;
     bool mRun;
     int mWindowWidth;
     int mWindowHeight;
+    LoopTiming mTiming;
+    std::string mTracePath;
+    uint64_t mSeed;
+    std::string mRecordPath;
+    InputLog mInputLog;
+    bool mHotReloadEnabled;
+    std::unique_ptr<HotReloader> mHotReload;
+    std::vector<SceneEdit> mSceneEdits; // latest version of each edited scene file
 
-    std::vector<std::unique_ptr<Scene>> mScenes;
+    std::unique_ptr<JobSystem> mJobs;
+    std::unique_ptr<SceneStreamer> mStreamer;
+    std::vector<std::string> mScenePaths;
+    std::unique_ptr<Scene> mScene;
     size_t mCurrentSceneIndex;
 };
 
@@ -0,0 +1,254 @@
+#include "ArchetypeStorage.h"
+
+/**
+ * @brief Appends a row for a new entity.
+ *
+ * The collision rectangle starts equal to the transform, the velocity at zero and the
+ * entity active with no texture.
+ *
+ * @param owner The entity that owns the row (non-owning back reference).
+ * @param x The initial x-coordinate.
+ * @param y The initial y-coordinate.
+ * @param w The initial width.
+ * @param h The initial height.
+ * @return StorageHandle A handle that stays valid until Release() or Clear().
+ */
+StorageHandle ArchetypeStorage::Allocate(GameEntity *owner, float x, float y, float w, float h)
+{
+    uint32_t slot;
+    if (!mFreeSlots.empty())
+    {
+        slot = mFreeSlots.back();
+        mFreeSlots.pop_back();
+    }
+    else
+    {
+        slot = static_cast<uint32_t>(mSlots.size());
+        mSlots.push_back(Slot{0, 0});
+    }
+
+    mSlots[slot].dense = static_cast<uint32_t>(mOwners.size());
+    mDenseToSlot.push_back(slot);
+
+    mX.push_back(x);
+    mY.push_back(y);
+    mW.push_back(w);
+    mH.push_back(h);
+    mPrevX.push_back(x);
+    mPrevY.push_back(y);
+    mCollX.push_back(x);
+    mCollY.push_back(y);
+    mCollW.push_back(w);
+    mCollH.push_back(h);
+    mVelX.push_back(0.0f);
+    mVelY.push_back(0.0f);
+    mActive.push_back(1);
+    mTextures.push_back(TextureHandle{});
+    mOwners.push_back(owner);
+
+    return StorageHandle{slot, mSlots[slot].generation};
+}
+
+/**
+ * @brief Reserves room for a number of rows, so bulk loads do not regrow the arrays.
+ *
+ * @param count The total number of rows to make room for.
+ */
+void ArchetypeStorage::Reserve(size_t count)
+{
+    mSlots.reserve(count);
+    mDenseToSlot.reserve(count);
+    for (auto *column : {&mX, &mY, &mW, &mH, &mPrevX, &mPrevY, &mCollX, &mCollY, &mCollW, &mCollH, &mVelX, &mVelY})
+        column->reserve(count);
+    mActive.reserve(count);
+    mTextures.reserve(count);
+    mOwners.reserve(count);
+}
+
+/**
+ * @brief Removes an entity's row by moving the last row into it.
+ *
+ * Releasing a stale handle (already released, or from before a Clear()) does nothing.
+ *
+ * @param handle The handle of the row to remove.
+ */
+void ArchetypeStorage::Release(StorageHandle handle)
+{
+    if (!IsValid(handle))
+        return;
+
+    const uint32_t row = mSlots[handle.index].dense;
+    const uint32_t last = static_cast<uint32_t>(mOwners.size() - 1);
+    if (row != last)
+    {
+        mX[row] = mX[last];
+        mY[row] = mY[last];
+        mW[row] = mW[last];
+        mH[row] = mH[last];
+        mPrevX[row] = mPrevX[last];
+        mPrevY[row] = mPrevY[last];
+        mCollX[row] = mCollX[last];
+        mCollY[row] = mCollY[last];
+        mCollW[row] = mCollW[last];
+        mCollH[row] = mCollH[last];
+        mVelX[row] = mVelX[last];
+        mVelY[row] = mVelY[last];
+        mActive[row] = mActive[last];
+        mTextures[row] = mTextures[last];
+        mOwners[row] = mOwners[last];
+        mDenseToSlot[row] = mDenseToSlot[last];
+        mSlots[mDenseToSlot[row]].dense = row;
+    }
+
+    mX.pop_back();
+    mY.pop_back();
+    mW.pop_back();
+    mH.pop_back();
+    mPrevX.pop_back();
+    mPrevY.pop_back();
+    mCollX.pop_back();
+    mCollY.pop_back();
+    mCollW.pop_back();
+    mCollH.pop_back();
+    mVelX.pop_back();
+    mVelY.pop_back();
+    mActive.pop_back();
+    mTextures.pop_back();
+    mOwners.pop_back();
+    mDenseToSlot.pop_back();
+
+    mSlots[handle.index].generation++;
+    mFreeSlots.push_back(handle.index);
+}
+
+/**
+ * @brief Checks whether a handle still refers to a live row.
+ *
+ * @param handle The handle to check.
+ * @return true if the handle is live, false if it is stale or was never allocated.
+ */
+bool ArchetypeStorage::IsValid(StorageHandle handle) const
+{
+    return handle.index < mSlots.size() && mSlots[handle.index].generation == handle.generation &&
+           mSlots[handle.index].dense < mDenseToSlot.size() && mDenseToSlot[mSlots[handle.index].dense] == handle.index;
+}
+
+/**
+ * @brief Removes every row and invalidates all outstanding handles.
+ */
+void ArchetypeStorage::Clear()
+{
+    for (uint32_t slot : mDenseToSlot)
+    {
+        mSlots[slot].generation++;
+        mFreeSlots.push_back(slot);
+    }
+    mX.clear();
+    mY.clear();
+    mW.clear();
+    mH.clear();
+    mPrevX.clear();
+    mPrevY.clear();
+    mCollX.clear();
+    mCollY.clear();
+    mCollW.clear();
+    mCollH.clear();
+    mVelX.clear();
+    mVelY.clear();
+    mActive.clear();
+    mTextures.clear();
+    mOwners.clear();
+    mDenseToSlot.clear();
+}
+
+/**
+ * @brief Moves every row by its velocity.
+ *
+ * @param deltaTime The time step in seconds.
+ */
+void ArchetypeStorage::Integrate(float deltaTime)
+{
+    const size_t count = Size();
+    for (size_t i = 0; i < count; ++i)
+    {
+        mX[i] += mVelX[i] * deltaTime;
+        mY[i] += mVelY[i] * deltaTime;
+    }
+}
+
+/**
+ * @brief Copies every transform rectangle into the matching collision rectangle.
+ *
+ * This is the batched form of Collision2DComponent::Update().
+ */
+void ArchetypeStorage::SyncCollision()
+{
+    mCollX = mX;
+    mCollY = mY;
+    mCollW = mW;
+    mCollH = mH;
+}
+
+/**
+ * @brief Records every row's position as the start of the next simulation step.
+ *
+ * Render() interpolates from these positions to the current ones.
+ */
+void ArchetypeStorage::SavePrevious()
+{
+    mPrevX = mX;
+    mPrevY = mY;
+}
+
+/**
+ * @brief Queues every active row for drawing.
+ *
+ * Each sprite is queued at its transform rectangle, showing its region of the atlas when
+ * the texture is atlased, and, for debugging purposes, its
+ * collision rectangle is outlined in red, as GameEntity::Render() does for one entity.
+ * Nothing is drawn until the queue is flushed.
+ *
+ * Rows are drawn at the position interpolated between the start (mPrevX, mPrevY) and the end
+ * of the last simulation step, so motion stays smooth when the render rate differs from the
+ * simulation rate.
+ *
+ * @param queue The frame's render queue.
+ * @param layer The layer for the sprites.
+ * @param debugLayer The layer for the collision outlines.
+ * @param alpha How far between the previous and current state to draw, 0 to 1.
+ */
+void ArchetypeStorage::Render(RenderQueue &queue, uint8_t layer, uint8_t debugLayer, float alpha) const
+{
+    const size_t count = Size();
+    for (size_t i = 0; i < count; ++i)
+        RenderRow(queue, i, layer, debugLayer, alpha);
+}
+
+/**
+ * @brief Queues one row's sprite and collision outline, as Render() does for every row.
+ *
+ * Inactive rows are skipped. Lets a StaticLayer redraw only the rows near a changed region.
+ *
+ * @param queue The render queue.
+ * @param i The dense row.
+ * @param layer The layer for the sprite.
+ * @param debugLayer The layer for the collision outline.
+ * @param alpha How far between the previous and current state to draw, 0 to 1.
+ */
+void ArchetypeStorage::RenderRow(RenderQueue &queue, size_t i, uint8_t layer, uint8_t debugLayer, float alpha) const
+{
+    if (!mActive[i])
+        return;
+    const ResourceManager &resources = ResourceManager::getInstance();
+    const SDL_Color red{255, 0, 0, 255};
+    const float dx = (mPrevX[i] - mX[i]) * (1.0f - alpha);
+    const float dy = (mPrevY[i] - mY[i]) * (1.0f - alpha);
+    SDL_FRect rect = GetRect(i);
+    rect.x += dx;
+    rect.y += dy;
+    SDL_FRect coll = GetCollisionRect(i);
+    coll.x += dx;
+    coll.y += dy;
+    queue.AddSprite(layer, resources.GetTexture(mTextures[i]), rect, resources.GetUV(mTextures[i]));
+    queue.AddOutline(debugLayer, coll, red);
+}
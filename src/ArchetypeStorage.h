@@ -0,0 +1,107 @@
+#ifndef ARCHETYPESTORAGE_H
+#define ARCHETYPESTORAGE_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <SDL2/SDL.h>
+#include "ResourceManager.h"
+#include "RenderQueue.h"
+
+class GameEntity;
+
+/**
+ * @brief Identifies an entity's row in an ArchetypeStorage.
+ *
+ * The index names a slot that survives swap-and-pop moves of the dense arrays; the
+ * generation is bumped whenever the slot is released, so a stale handle can be detected.
+ */
+struct StorageHandle
+{
+    uint32_t index = UINT32_MAX;
+    uint32_t generation = 0;
+};
+
+/**
+ * @brief The ArchetypeStorage class keeps the hot data of one kind of entity in contiguous arrays.
+ *
+ * Each kind (paddle, balls, bricks, drops) gets its own storage. Position, size, collision
+ * rectangle, velocity, active flag and texture of every entity live in parallel dense arrays
+ * (structure of arrays), so systems such as ball movement, collision and rendering are linear
+ * sweeps over memory instead of pointer chases across the heap. TransformComponent and
+ * Collision2DComponent are thin views onto a row of this storage.
+ *
+ * Rows are kept dense: releasing an entity moves the last row into the freed one.
+ */
+class ArchetypeStorage
+{
+public:
+    ArchetypeStorage() = default;
+    ArchetypeStorage(const ArchetypeStorage &) = delete;
+    ArchetypeStorage &operator=(const ArchetypeStorage &) = delete;
+
+    StorageHandle Allocate(GameEntity *owner, float x, float y, float w, float h);
+    void Release(StorageHandle handle);
+    void Reserve(size_t count);
+    bool IsValid(StorageHandle handle) const;
+    void Clear();
+
+    /**
+     * @brief Returns the dense row index of a live handle.
+     *
+     * @param handle A handle returned by Allocate() that has not been released.
+     * @return size_t The row in the dense arrays.
+     */
+    size_t Dense(StorageHandle handle) const { return mSlots[handle.index].dense; }
+
+    /**
+     * @brief Returns the number of live rows.
+     *
+     * @return size_t The number of entities stored.
+     */
+    size_t Size() const { return mOwners.size(); }
+
+    /**
+     * @brief Returns the transform rectangle of a row.
+     *
+     * @param i The dense row index.
+     * @return SDL_FRect The position and size.
+     */
+    SDL_FRect GetRect(size_t i) const { return SDL_FRect{mX[i], mY[i], mW[i], mH[i]}; }
+
+    /**
+     * @brief Returns the collision rectangle of a row.
+     *
+     * @param i The dense row index.
+     * @return SDL_FRect The collision rectangle.
+     */
+    SDL_FRect GetCollisionRect(size_t i) const { return SDL_FRect{mCollX[i], mCollY[i], mCollW[i], mCollH[i]}; }
+
+    void Integrate(float deltaTime);
+    void SyncCollision();
+    void SavePrevious();
+    void Render(RenderQueue &queue, uint8_t layer, uint8_t debugLayer, float alpha = 1.0f) const;
+    void RenderRow(RenderQueue &queue, size_t i, uint8_t layer, uint8_t debugLayer, float alpha = 1.0f) const;
+
+    // Dense per-entity arrays; element i of every array belongs to the same entity.
+    std::vector<float> mX, mY, mW, mH;
+    std::vector<float> mPrevX, mPrevY; // position at the start of the last simulation step
+    std::vector<float> mCollX, mCollY, mCollW, mCollH;
+    std::vector<float> mVelX, mVelY;
+    std::vector<uint8_t> mActive;
+    std::vector<TextureHandle> mTextures;
+    std::vector<GameEntity *> mOwners;
+
+private:
+    struct Slot
+    {
+        uint32_t dense;
+        uint32_t generation;
+    };
+
+    std::vector<Slot> mSlots;
+    std::vector<uint32_t> mDenseToSlot;
+    std::vector<uint32_t> mFreeSlots;
+};
+
+#endif
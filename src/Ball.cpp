@@ -3,64 +3,80 @@
 #include "../include/ComponentType.hpp"
 #include <SDL2/SDL.h>
 
+/**
+ * @brief Moves one ball and bounces it off the top, left and right screen boundaries.
+ *
+ * Used by Ball::Update().
+ */
+static inline void StepBall(float &x, float &y, float w, float &velX, float &velY, float deltaTime)
+{
+    x += velX * deltaTime;
+    y += velY * deltaTime;
+
+    if (y <= 0)
+    {
+        y = 0;
+        velY = -velY;
+    }
+    if (x <= 0)
+    {
+        x = 0;
+        velX = -velX;
+    }
+    if (x + w >= 1600)
+    {
+        x = 1600 - w;
+        velX = -velX;
+    }
+}
+
 /**
  * @brief Constructs a new Ball object.
  *
- * Initializes the ball with the specified base speed and default velocities.
+ * The ball gets its default velocity once initComponents() has given it a storage row.
  *
  * @param renderer The SDL_Renderer used for texture creation.
  * @param texturePath The path to the ball texture (BMP format).
  * @param speed The base speed value for the ball.
  */
 Ball::Ball(SDL_Renderer *renderer, const char *texturePath, float speed)
-    : GameEntity(renderer, texturePath, speed), velX(250.0f), velY(250.0f)
+    : GameEntity(renderer, texturePath, speed)
+{
+}
+
+/**
+ * @brief Initializes the ball's components and sets its default velocity (250, 250).
+ *
+ * @param texture The ball texture.
+ * @param storage The scene's ball storage.
+ */
+void Ball::initComponents(TextureHandle texture, ArchetypeStorage *storage)
 {
+    GameEntity::initComponents(texture, storage);
+    SetVelocity(250.0f, 250.0f);
 }
 
 /**
  * @brief Updates the ball's state.
  *
- * The function retrieves the current position from the TransformComponent, updates the ball's position using the velocity and deltaTime,
+ * The function updates the ball's position using the velocity and deltaTime and
  * handles collisions with screen boundaries:
  *  - If the ball hits the top, it reverses vertical direction.
  *  - If it hits the left or right boundaries, it reverses horizontal direction.
- * Finally, it moves the ball to the new position and updates the Collision2DComponent.
+ * Finally, it updates the Collision2DComponent.
  *
  * @param deltaTime The time elapsed since the last frame in seconds.
  */
 void Ball::Update(float deltaTime)
 {
-    auto trans = GetComponent<TransformComponent>(ComponentType::TransformComponent);
-    if (!trans)
+    if (!mStorage)
         return;
 
-    float x = trans->getX();
-    float y = trans->getY();
-    float w = trans->getW();
-    float h = trans->getH();
-
-    x += velX * deltaTime;
-    y += velY * deltaTime;
-
-    if (y <= 0)
-    {
-        y = 0;
-        velY = -velY;
-    }
-    if (x <= 0)
-    {
-        x = 0;
-        velX = -velX;
-    }
-    if (x + w >= 1600)
-    {
-        x = 1600 - w;
-        velX = -velX;
-    }
-
-    trans->move(x, y);
+    size_t row = StorageRow();
+    StepBall(mStorage->mX[row], mStorage->mY[row], mStorage->mW[row],
+             mStorage->mVelX[row], mStorage->mVelY[row], deltaTime);
 
-    auto coll = GetComponent<Collision2DComponent>(ComponentType::Collision2DComponent);
+    auto coll = GetComponent<Collision2DComponent>();
     if (coll)
     {
         coll->Update(deltaTime);
@@ -77,6 +93,7 @@ void Ball::Update(float deltaTime)
  */
 void Ball::SetVelocity(float vx, float vy)
 {
-    velX = vx;
-    velY = vy;
+    size_t row = StorageRow();
+    mStorage->mVelX[row] = vx;
+    mStorage->mVelY[row] = vy;
 }
@@ -7,41 +7,40 @@
  * @brief The Ball class represents the ball in the game.
  *
  * It inherits from GameEntity and handles its own motion, collision with screen boundaries and velocity updates.
+ * The velocity lives next to the transform in the ball's ArchetypeStorage row. Update() moves a
+ * single ball discretely; a Scene moves all of its balls at once with continuous collision.
  */
 class Ball : public GameEntity
 {
 public:
     Ball(SDL_Renderer *renderer, const char *texturePath, float speed);
+    virtual void initComponents(TextureHandle texture, ArchetypeStorage *storage) override;
     virtual void Update(float deltaTime) override;
     void SetVelocity(float vx, float vy);
 
     /**
      * @brief Reverses the horizontal velocity of the ball.
      */
-    void ReverseVelX() { velX = -velX; }
+    void ReverseVelX() { mStorage->mVelX[StorageRow()] *= -1.0f; }
 
     /**
      * @brief Reverses the vertical velocity of the ball.
      */
-    void ReverseVelY() { velY = -velY; }
+    void ReverseVelY() { mStorage->mVelY[StorageRow()] *= -1.0f; }
 
     /**
      * @brief Gets the horizontal velocity of the ball.
      *
      * @return float The horizontal velocity.
      */
-    float GetVelX() const { return velX; }
+    float GetVelX() const { return mStorage->mVelX[StorageRow()]; }
 
     /**
      * @brief Gets the vertical velocity of the ball.
      *
      * @return float The vertical velocity.
      */
-    float GetVelY() const { return velY; }
-
-private:
-    float velX;
-    float velY;
+    float GetVelY() const { return mStorage->mVelY[StorageRow()]; }
 };
 
 #endif
@@ -0,0 +1,156 @@
+#include "BatchRunner.h"
+#include "Scene.h"
+#include "PaddleController.h"
+#include "Random.h"
+#include <SDL2/SDL.h>
+#include <algorithm>
+#include <iostream>
+#include <memory>
+
+/**
+ * @brief Constructs a runner; call LoadScenes() before Run().
+ *
+ * @param options The scenes, game count, frame cap, timestep, seed and controller name.
+ */
+BatchRunner::BatchRunner(const BatchOptions &options) : mOptions(options)
+{
+}
+
+/**
+ * @brief Parses every scene of the batch once and checks the controller name.
+ *
+ * @return bool True if all scenes were read and the controller exists.
+ */
+bool BatchRunner::LoadScenes()
+{
+    if (!MakePaddleController(mOptions.controller, 0))
+    {
+        std::cerr << "Unknown controller: " << mOptions.controller << ". Available: " << PaddleControllerNames() << std::endl;
+        return false;
+    }
+    if (mOptions.scenes.empty())
+    {
+        std::cerr << "A batch needs at least one scene" << std::endl;
+        return false;
+    }
+    mScenes.assign(mOptions.scenes.size(), SceneData());
+    for (size_t i = 0; i < mOptions.scenes.size(); ++i)
+    {
+        if (!LoadSceneData(mOptions.scenes[i], mScenes[i]))
+            return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Plays every game of the batch and aggregates the results.
+ *
+ * Games are handed to the job system one at a time, so a few long games do not hold up
+ * a thread's share of short ones. Each game writes only its own result; the statistics are
+ * summed afterwards in game order.
+ *
+ * @param jobs The job system to spread the games over.
+ * @return BatchStats The aggregated results and the wall-clock time taken.
+ */
+BatchStats BatchRunner::Run(JobSystem &jobs)
+{
+    mResults.assign(mOptions.games, GameResult());
+
+    const Uint64 start = SDL_GetPerformanceCounter();
+    jobs.ParallelFor(mOptions.games, 1, [this](size_t begin, size_t end)
+                     {
+                         for (size_t game = begin; game < end; ++game)
+                             mResults[game] = PlayGame(game);
+                     });
+    const Uint64 end = SDL_GetPerformanceCounter();
+
+    BatchStats stats;
+    stats.games = mResults.size();
+    stats.seconds = static_cast<double>(end - start) / static_cast<double>(SDL_GetPerformanceFrequency());
+    std::vector<long> framesToClear;
+    for (const GameResult &result : mResults)
+    {
+        stats.frames += result.frames;
+        stats.ballsLost += result.ballsLost;
+        stats.score += result.score;
+        if (result.cleared)
+            framesToClear.push_back(result.frames);
+    }
+    stats.cleared = framesToClear.size();
+    if (!framesToClear.empty())
+    {
+        std::sort(framesToClear.begin(), framesToClear.end());
+        uint64_t total = 0;
+        for (long frames : framesToClear)
+            total += frames;
+        stats.meanFramesToClear = static_cast<double>(total) / framesToClear.size();
+        stats.medianFramesToClear = framesToClear[framesToClear.size() / 2];
+        stats.p90FramesToClear = framesToClear[(framesToClear.size() * 9) / 10];
+    }
+    return stats;
+}
+
+/**
+ * @brief Plays one game: the scenes in order until game over, the last scene is cleared or the frame cap.
+ *
+ * The Scene has no job system, so the game runs entirely on the calling thread.
+ *
+ * @param game The game's index, which determines its seeds.
+ * @return GameResult The game's outcome.
+ */
+GameResult BatchRunner::PlayGame(size_t game) const
+{
+    const uint64_t gameSeed = MixSeed(mOptions.seed, game);
+    // Scenes use streams 0..N-1 of the game's seed; the controller takes the last stream.
+    std::unique_ptr<PaddleController> controller = MakePaddleController(mOptions.controller, MixSeed(gameSeed, UINT64_MAX));
+
+    GameResult result;
+    size_t sceneIndex = 0;
+    Scene scene;
+    scene.Load(ViewScene(mScenes[sceneIndex]), nullptr);
+    scene.SetSeed(MixSeed(gameSeed, sceneIndex));
+    while (result.frames < mOptions.maxFrames)
+    {
+        scene.Input(mOptions.dt, controller->Decide(scene));
+        scene.Update(mOptions.dt);
+        ++result.frames;
+        if (scene.IsGameOver())
+            break;
+        if (!scene.GetSceneStatus())
+        {
+            result.ballsLost += scene.GetBallsLost();
+            result.score += scene.GetScore();
+            ++result.scenesCleared;
+            if (++sceneIndex >= mScenes.size())
+            {
+                result.cleared = true;
+                return result;
+            }
+            scene.Load(ViewScene(mScenes[sceneIndex]), nullptr);
+            scene.SetSeed(MixSeed(gameSeed, sceneIndex));
+        }
+    }
+    result.ballsLost += scene.GetBallsLost();
+    result.score += scene.GetScore();
+    return result;
+}
+
+/**
+ * @brief Prints a batch's statistics, with games per second as the headline figure.
+ *
+ * @param stats The statistics returned by BatchRunner::Run().
+ * @param threads The thread count the batch ran on.
+ */
+void PrintBatchStats(const BatchStats &stats, unsigned threads)
+{
+    std::cout << stats.games << " games on " << threads << " thread(s) in " << stats.seconds << "s: "
+              << stats.GamesPerSecond() << " games/s (" << (stats.seconds > 0.0 ? stats.frames / stats.seconds : 0.0)
+              << " frames/s)" << std::endl;
+    std::cout << "  clear rate: " << 100.0 * stats.ClearRate() << "% (" << stats.cleared << "/" << stats.games << ")" << std::endl;
+    if (stats.cleared)
+        std::cout << "  frames to clear: mean " << stats.meanFramesToClear << ", median " << stats.medianFramesToClear
+                  << ", p90 " << stats.p90FramesToClear << std::endl;
+    std::cout << "  balls lost: " << stats.ballsLost << " (" << (stats.games ? static_cast<double>(stats.ballsLost) / stats.games : 0.0)
+              << " per game)" << std::endl;
+    std::cout << "  mean score: " << (stats.games ? static_cast<double>(stats.score) / stats.games : 0.0) << std::endl;
+}
@@ -0,0 +1,95 @@
+#ifndef BATCHRUNNER_H
+#define BATCHRUNNER_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "SceneFile.h"
+#include "JobSystem.h"
+
+/**
+ * @brief What a batch plays: the scene list, how many games, and who holds the paddle.
+ */
+struct BatchOptions
+{
+    std::vector<std::string> scenes;
+    size_t games = 1000;
+    long maxFrames = 1000000; // per game (about 4.6 hours at 60 Hz); a game still running then counts as not cleared
+    float dt = 1.0f / 60.0f;
+    uint64_t seed = 0;
+    std::string controller = "track";
+};
+
+/**
+ * @brief The outcome of one game.
+ */
+struct GameResult
+{
+    bool cleared = false;       // every scene was cleared
+    uint32_t scenesCleared = 0;
+    long frames = 0;            // steps played, up to the frame cap
+    uint32_t ballsLost = 0;     // over all scenes played
+    uint64_t score = 0;         // over all scenes played
+};
+
+/**
+ * @brief A batch's results aggregated over its games.
+ */
+struct BatchStats
+{
+    size_t games = 0;
+    size_t cleared = 0;
+    uint64_t frames = 0;
+    uint64_t ballsLost = 0;
+    uint64_t score = 0;
+    double meanFramesToClear = 0.0;  // over cleared games
+    long medianFramesToClear = 0;
+    long p90FramesToClear = 0;
+    double seconds = 0.0;
+
+    /**
+     * @brief Returns the share of games that cleared every scene.
+     */
+    double ClearRate() const { return games ? static_cast<double>(cleared) / games : 0.0; }
+
+    /**
+     * @brief Returns the batch's throughput.
+     */
+    double GamesPerSecond() const { return seconds > 0.0 ? games / seconds : 0.0; }
+};
+
+/**
+ * @brief The BatchRunner class plays many independent headless games in parallel.
+ *
+ * The scenes are parsed once; every game then builds its own Scene from the records (see
+ * Scene::Load()) and steps it on a single thread, with no window, renderer or console
+ * output, while the games themselves are spread over a job system. Game i is seeded with
+ * MixSeed(seed, i): its scenes with MixSeed() of that per scene and its controller with its
+ * own stream, so the results depend on the seed and never on the thread count.
+ */
+class BatchRunner
+{
+public:
+    explicit BatchRunner(const BatchOptions &options);
+
+    bool LoadScenes();
+    BatchStats Run(JobSystem &jobs);
+
+    /**
+     * @brief Returns the last Run()'s per-game results, indexed by game.
+     *
+     * @return const std::vector<GameResult>& The results.
+     */
+    const std::vector<GameResult> &GetResults() const { return mResults; }
+
+private:
+    GameResult PlayGame(size_t game) const;
+
+    BatchOptions mOptions;
+    std::vector<SceneData> mScenes;
+    std::vector<GameResult> mResults;
+};
+
+void PrintBatchStats(const BatchStats &stats, unsigned threads);
+
+#endif
@@ -0,0 +1,1497 @@
+#include "Benchmark.h"
+#include "Ball.h"
+#include "Scene.h"
+#include "FramePacer.h"
+#include "Profiler.h"
+#include "JobSystem.h"
+#include "AABBBatch.h"
+#include "SceneFile.h"
+#include "MappedFile.h"
+#include "SceneStreamer.h"
+#include "BatchRunner.h"
+#include "VectorEnv.h"
+#include "HotReloader.h"
+#include "InputComponent.h"
+#include <algorithm>
+#include <bitset>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <sstream>
+#include <vector>
+#include <SDL2/SDL.h>
+
+namespace
+{
+    /**
+     * @brief Returns the seconds elapsed since a SDL_GetPerformanceCounter() sample.
+     */
+    double SecondsSince(Uint64 start)
+    {
+        return static_cast<double>(SDL_GetPerformanceCounter() - start) / static_cast<double>(SDL_GetPerformanceFrequency());
+    }
+
+    /**
+     * @brief Compares component lookup through the former std::map + dynamic_pointer_cast
+     * path against GameEntity's typed slots.
+     *
+     * The "map" variant rebuilds each entity's components into a std::map keyed by
+     * ComponentType and returns shared_ptr copies, exactly as GetComponent used to.
+     */
+    int BenchComponentLookup()
+    {
+        const int entityCount = 1024;
+        const int rounds = 2000;
+
+        ArchetypeStorage storage;
+        std::vector<std::shared_ptr<Ball>> balls;
+        std::vector<std::map<ComponentType, std::shared_ptr<Component>>> maps(entityCount);
+        TextureHandle texture = ResourceManager::getInstance().LoadTexture("../Assets/ball.bmp", nullptr);
+        for (int i = 0; i < entityCount; ++i)
+        {
+            auto ball = std::make_shared<Ball>(nullptr, "../Assets/ball.bmp", 250.0f);
+            ball->initComponents(texture, &storage);
+            ball->GetTransform()->move(static_cast<float>(i), 0);
+            for (size_t slot = 0; slot < ball->mComponents.size(); ++slot)
+            {
+                if (ball->mComponents[slot])
+                    maps[i][static_cast<ComponentType>(slot)] = ball->mComponents[slot];
+            }
+            balls.push_back(ball);
+        }
+
+        const double lookups = static_cast<double>(entityCount) * rounds * 2;
+
+        float mapSum = 0;
+        Uint64 start = SDL_GetPerformanceCounter();
+        for (int r = 0; r < rounds; ++r)
+        {
+            for (auto &components : maps)
+            {
+                auto it = components.find(ComponentType::TransformComponent);
+                std::shared_ptr<TransformComponent> trans = it != components.end() ? std::dynamic_pointer_cast<TransformComponent>(it->second) : nullptr;
+                auto itc = components.find(ComponentType::Collision2DComponent);
+                std::shared_ptr<Collision2DComponent> coll = itc != components.end() ? std::dynamic_pointer_cast<Collision2DComponent>(itc->second) : nullptr;
+                mapSum += trans->getX() + coll->getW();
+            }
+        }
+        double mapSeconds = SecondsSince(start);
+
+        float slotSum = 0;
+        start = SDL_GetPerformanceCounter();
+        for (int r = 0; r < rounds; ++r)
+        {
+            for (auto &ball : balls)
+            {
+                auto trans = ball->GetComponent<TransformComponent>();
+                auto coll = ball->GetComponent<Collision2DComponent>();
+                slotSum += trans->getX() + coll->getW();
+            }
+        }
+        double slotSeconds = SecondsSince(start);
+
+        std::cout << "component lookup, " << entityCount << " entities x " << rounds << " rounds x 2 lookups" << std::endl;
+        std::cout << "  std::map + dynamic_pointer_cast: " << mapSeconds * 1e9 / lookups << " ns/lookup" << std::endl;
+        std::cout << "  typed slots:                     " << slotSeconds * 1e9 / lookups << " ns/lookup" << std::endl;
+        return mapSum == slotSum ? 0 : 1;
+    }
+
+    /**
+     * @brief Returns the resident set size of this process, in bytes, or 0 where unsupported.
+     */
+    size_t CurrentRssBytes()
+    {
+#ifdef __linux__
+        std::ifstream statm("/proc/self/statm");
+        size_t pages = 0, resident = 0;
+        if (statm >> pages >> resident)
+            return resident * 4096;
+#endif
+        return 0;
+    }
+
+    /**
+     * @brief Returns the peak resident set size since the last ResetPeakRss(), in bytes, or 0 where unsupported.
+     */
+    size_t PeakRssBytes()
+    {
+#ifdef __linux__
+        std::ifstream status("/proc/self/status");
+        std::string key;
+        while (status >> key)
+        {
+            size_t kilobytes = 0;
+            if (key == "VmHWM:" && status >> kilobytes)
+                return kilobytes * 1024;
+        }
+#endif
+        return 0;
+    }
+
+    /**
+     * @brief Restarts the peak resident set size measurement at the current size, where supported.
+     */
+    void ResetPeakRss()
+    {
+#ifdef __linux__
+        std::ofstream clearRefs("/proc/self/clear_refs");
+        clearRefs << "5";
+#endif
+    }
+
+    /**
+     * @brief Spawns and kills one million drops and checks that memory stays flat.
+     *
+     * Fails if the entity count does not return to its starting value or if RSS grows by
+     * more than 1 MB between the warm-up sample and the end of the run.
+     */
+    int BenchSoakDrops()
+    {
+        const long iterations = 1000000;
+        const long warmup = 10000;
+
+        Scene scene;
+        scene.LoadFromFile("../Scenes/scene1.txt", nullptr);
+        const size_t entitiesBefore = scene.GetEntityCount();
+
+        size_t rssWarm = 0;
+        Uint64 start = SDL_GetPerformanceCounter();
+        for (long i = 0; i < iterations; ++i)
+        {
+            EntityHandle drop = scene.SpawnDrop(static_cast<float>(i % 1600), 0.0f);
+            scene.DestroyDrop(drop);
+            if (scene.GetEntity(drop))
+            {
+                std::cerr << "destroyed drop still resolves" << std::endl;
+                return 1;
+            }
+            if (i == warmup)
+                rssWarm = CurrentRssBytes();
+        }
+        double seconds = SecondsSince(start);
+        size_t rssEnd = CurrentRssBytes();
+
+        std::cout << "soak: " << iterations << " drops spawned and destroyed in " << seconds << "s" << std::endl;
+        std::cout << "  entities before/after: " << entitiesBefore << "/" << scene.GetEntityCount() << std::endl;
+        std::cout << "  RSS after warm-up: " << rssWarm / 1024 << " KB, at end: " << rssEnd / 1024 << " KB" << std::endl;
+
+        if (scene.GetEntityCount() != entitiesBefore)
+            return 1;
+        if (rssEnd > rssWarm + 1024 * 1024)
+        {
+            std::cerr << "RSS grew during the soak: leak suspected" << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    /**
+     * @brief Times ball-multiplication events: a drop lands on the paddle every step until the balls number 8192.
+     *
+     * The first event of a fresh scene fills the ball pool; later events in the same Scene
+     * (reloaded, which returns every ball to the pool) and events after ReserveSpawns()
+     * reuse pooled balls, so their worst step should be no slower than a steady one.
+     */
+    int BenchMultiball()
+    {
+        const size_t maxBalls = 8192;
+        const float dt = 1.0f / 60.0f;
+
+        auto runEvent = [&](Scene &scene, const char *label)
+        {
+            const size_t constructedBefore = scene.GetPooledEntityCount();
+            double worst = 0, total = 0;
+            int steps = 0;
+            SDL_FRect paddle{};
+            while (scene.GetBallStorage().Size() < maxBalls && scene.GetSceneStatus() && scene.GetPaddleRect(paddle))
+            {
+                scene.SpawnDrop(paddle.x + 8.0f, paddle.y - 4.0f);
+                Uint64 start = SDL_GetPerformanceCounter();
+                scene.Update(dt);
+                double seconds = SecondsSince(start);
+                worst = std::max(worst, seconds);
+                total += seconds;
+                ++steps;
+            }
+            std::cout << "  " << label << ": " << steps << " steps to " << scene.GetBallStorage().Size() << " balls, "
+                      << total * 1000.0 << " ms total, worst step " << worst * 1000.0 << " ms, "
+                      << scene.GetPooledEntityCount() - constructedBefore << " entities constructed" << std::endl;
+        };
+
+        std::cout << "ball multiplication on scene1 up to " << maxBalls << " balls" << std::endl;
+        Scene scene;
+        scene.LoadFromFile("../Scenes/scene1.txt", nullptr);
+        runEvent(scene, "cold pools");
+        scene.LoadFromFile("../Scenes/scene1.txt", nullptr);
+        runEvent(scene, "warm pools");
+
+        Scene reserved;
+        reserved.LoadFromFile("../Scenes/scene1.txt", nullptr);
+        reserved.ReserveSpawns(maxBalls * 2, 64);
+        runEvent(reserved, "ReserveSpawns()");
+        return 0;
+    }
+
+    /**
+     * @brief Renders scene3 for a number of frames and returns the mean frame time in milliseconds.
+     */
+    double RenderSceneFrames(SDL_Renderer *renderer, int frames, int &drawCalls)
+    {
+        Scene scene;
+        scene.LoadFromFile("../Scenes/scene3.txt", renderer);
+        Uint64 start = SDL_GetPerformanceCounter();
+        for (int i = 0; i < frames; ++i)
+        {
+            SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+            SDL_RenderClear(renderer);
+            scene.Render(renderer);
+            SDL_RenderPresent(renderer);
+        }
+        double seconds = SecondsSince(start);
+        drawCalls = scene.GetDrawCalls();
+        return seconds * 1000.0 / frames;
+    }
+
+    /**
+     * @brief Renders scene3 into an off-screen software renderer, with one texture per sprite
+     * and then with the texture atlas, and reports frame time and draw calls per frame.
+     *
+     * The software renderer draws into a plain SDL_Surface, so no window or GPU is needed and the
+     * numbers are comparable across machines.
+     */
+    int BenchRender()
+    {
+        const int frames = 300;
+
+        SDL_Surface *target = SDL_CreateRGBSurfaceWithFormat(0, 1600, 1000, 32, SDL_PIXELFORMAT_ARGB8888);
+        SDL_Renderer *renderer = target ? SDL_CreateSoftwareRenderer(target) : nullptr;
+        if (!renderer)
+        {
+            std::cerr << "Failed to create software renderer: " << SDL_GetError() << std::endl;
+            SDL_FreeSurface(target);
+            return 1;
+        }
+
+        ResourceManager &resources = ResourceManager::getInstance();
+        int separateCalls = 0, atlasCalls = 0;
+        resources.Clear();
+        double separateMs = RenderSceneFrames(renderer, frames, separateCalls);
+        resources.Clear();
+        bool atlas = resources.BuildAtlas(SpriteAssetPaths(), renderer);
+        double atlasMs = RenderSceneFrames(renderer, frames, atlasCalls);
+        resources.Clear();
+
+        std::cout << "render scene3, " << frames << " frames (software renderer)" << std::endl;
+        std::cout << "  separate textures: " << separateMs << " ms/frame, " << separateCalls << " draw calls/frame" << std::endl;
+        std::cout << "  texture atlas:     " << atlasMs << " ms/frame, " << atlasCalls << " draw calls/frame" << std::endl;
+
+        SDL_DestroyRenderer(renderer);
+        SDL_FreeSurface(target);
+        return atlas ? 0 : 1;
+    }
+
+    /**
+     * @brief Writes a scene with a paddle, a ball and a cols x rows grid of overlapping bricks.
+     */
+    bool WriteBrickFieldScene(const std::string &path, int cols, int rows, float stepX, float stepY)
+    {
+        std::ofstream out(path);
+        out << "PADDLE 700 900\n";
+        out << "BALL 800 800 70 -70\n";
+        for (int r = 0; r < rows; ++r)
+        {
+            for (int c = 0; c < cols; ++c)
+                out << "BRICK " << 10.0f + c * stepX << " " << 20.0f + r * stepY << "\n";
+        }
+        return static_cast<bool>(out);
+    }
+
+    /**
+     * @brief Renders brick fields of 1k and 10k bricks with and without the static brick layer
+     * while balls break bricks, and reports render time, draw calls and bricks redrawn.
+     *
+     * Only Scene::Render() is timed; the simulation steps between frames are not. Both modes
+     * see the same bricks break, since the scenes are seeded alike and rendering does not feed
+     * back into the simulation.
+     */
+    int BenchStaticLayer()
+    {
+        const int frames = 300;
+        const float dt = 1.0f / 60.0f;
+
+        SDL_Surface *target = SDL_CreateRGBSurfaceWithFormat(0, 1600, 1000, 32, SDL_PIXELFORMAT_ARGB8888);
+        SDL_Renderer *renderer = target ? SDL_CreateSoftwareRenderer(target) : nullptr;
+        if (!renderer)
+        {
+            std::cerr << "Failed to create software renderer: " << SDL_GetError() << std::endl;
+            SDL_FreeSurface(target);
+            return 1;
+        }
+
+        struct Field
+        {
+            const char *path;
+            int cols, rows;
+            float stepX, stepY;
+        };
+        const Field fields[] = {
+            {"bench_bricks_1k.txt", 40, 25, 38.0f, 24.0f},
+            {"bench_bricks_10k.txt", 125, 80, 12.5f, 8.0f},
+        };
+
+        bool ok = true;
+        for (const Field &field : fields)
+        {
+            if (!WriteBrickFieldScene(field.path, field.cols, field.rows, field.stepX, field.stepY))
+            {
+                std::cerr << "Failed to write " << field.path << std::endl;
+                ok = false;
+                continue;
+            }
+            std::cout << "render " << field.cols * field.rows << " bricks, " << frames << " frames (software renderer)" << std::endl;
+            for (bool cached : {false, true})
+            {
+                Scene scene;
+                scene.SetStaticBrickLayer(cached);
+                scene.LoadFromFile(field.path, renderer);
+                scene.SetSeed(42);
+                for (int i = 0; i < 64; ++i)
+                    scene.SpawnBall(40.0f + i * 24.0f, 860.0f, (i % 2 ? 1.0f : -1.0f) * (120.0f + i), -400.0f);
+
+                double seconds = 0;
+                size_t redrawn = 0;
+                for (int i = 0; i < frames; ++i)
+                {
+                    scene.Update(dt);
+                    Uint64 start = SDL_GetPerformanceCounter();
+                    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
+                    SDL_RenderClear(renderer);
+                    scene.Render(renderer);
+                    SDL_RenderPresent(renderer);
+                    seconds += SecondsSince(start);
+                    redrawn += scene.GetBrickLayerRedraws();
+                }
+                std::cout << "  " << (cached ? "static layer: " : "per brick:    ") << seconds * 1000.0 / frames << " ms/frame, "
+                          << scene.GetDrawCalls() << " draw calls/frame, " << scene.GetBricksBroken() << " bricks broken";
+                if (cached)
+                    std::cout << ", " << redrawn << " bricks redrawn into the layer";
+                std::cout << std::endl;
+                scene.ReleaseRenderTargets();
+            }
+            std::remove(field.path);
+        }
+
+        SDL_DestroyRenderer(renderer);
+        SDL_FreeSurface(target);
+        return ok ? 0 : 1;
+    }
+
+    /**
+     * @brief Paces 300 empty frames at 60 Hz and reports how close each lands to its deadline.
+     *
+     * Fails if the median frame is more than 0.1ms late. Individual late frames are counted but
+     * tolerated: on a loaded or single-core machine the OS can preempt the spin phase.
+     */
+    int BenchPacer()
+    {
+        const int frames = 300;
+        const double tolerance = 0.0001;
+
+        FramePacer pacer(1.0 / 60.0);
+        std::vector<double> errors;
+        Uint64 start = SDL_GetPerformanceCounter();
+        for (int i = 0; i < frames; ++i)
+        {
+            pacer.Wait();
+            errors.push_back(pacer.GetLastError());
+        }
+        double seconds = SecondsSince(start);
+
+        std::sort(errors.begin(), errors.end());
+        long late = std::count_if(errors.begin(), errors.end(), [&](double e)
+                                  { return e > tolerance; });
+        double median = errors[frames / 2];
+
+        std::cout << "frame pacer, " << frames << " frames at 60 Hz in " << seconds << "s" << std::endl;
+        std::cout << "  error median: " << median * 1e6 << " us, p99: " << errors[frames * 99 / 100] * 1e6
+                  << " us, worst: " << errors.back() * 1e6 << " us" << std::endl;
+        std::cout << "  frames later than 0.1ms: " << late << std::endl;
+        return median <= tolerance ? 0 : 1;
+    }
+
+    /**
+     * @brief Measures the cost of one profiler zone (two counter reads and a ring buffer store).
+     *
+     * ProfileZone is used directly, so the figure is the real cost whether or not BRICK_PROFILE
+     * is defined. Fails if a zone costs 50 ns or more.
+     */
+    int BenchProfiler()
+    {
+        const int zones = 10000000;
+
+        Uint64 start = SDL_GetPerformanceCounter();
+        for (int i = 0; i < zones; ++i)
+        {
+            ProfileZone zone("bench");
+        }
+        double seconds = SecondsSince(start);
+        Profiler::Reset();
+
+        double perZone = seconds * 1e9 / zones;
+
+        std::cout << "profiler, " << zones << " empty zones" << std::endl;
+        std::cout << "  " << perZone << " ns/zone (target < 50)" << std::endl;
+        return perZone < 50.0 ? 0 : 1;
+    }
+
+    /**
+     * @brief Plays the same batch of scripted games on 1 to N threads.
+     *
+     * Games share nothing but the parsed scenes, so games/s should grow with the thread count
+     * up to the number of cores; every run must also produce the same per-game results.
+     */
+    int BenchBatch()
+    {
+        BatchOptions options;
+        options.scenes = {"../Scenes/scene1.txt"};
+        options.games = 64;
+        options.seed = 42;
+        BatchRunner runner(options);
+        if (!runner.LoadScenes())
+            return 1;
+
+        const unsigned maxThreads = std::max(JobSystem::DefaultThreadCount(), 4u);
+        std::cout << options.games << " '" << options.controller << "' games of up to " << options.maxFrames << " frames ("
+                  << JobSystem::DefaultThreadCount() << " hardware threads)" << std::endl;
+
+        std::vector<GameResult> expected;
+        double singleRate = 0;
+        bool deterministic = true;
+        for (unsigned threads = 1; threads <= maxThreads; threads *= 2)
+        {
+            JobSystem jobs(threads);
+            BatchStats stats = runner.Run(jobs);
+            const std::vector<GameResult> &results = runner.GetResults();
+            if (threads == 1)
+            {
+                expected = results;
+                singleRate = stats.GamesPerSecond();
+            }
+            bool match = true;
+            for (size_t i = 0; i < results.size(); ++i)
+            {
+                match = match && results[i].cleared == expected[i].cleared && results[i].frames == expected[i].frames &&
+                        results[i].ballsLost == expected[i].ballsLost && results[i].scenesCleared == expected[i].scenesCleared &&
+                        results[i].score == expected[i].score;
+            }
+            deterministic = deterministic && match;
+            double speedup = singleRate > 0.0 ? stats.GamesPerSecond() / singleRate : 0.0;
+            std::cout << "  " << threads << " thread(s): " << stats.GamesPerSecond() << " games/s, speedup " << speedup
+                      << "x (" << 100.0 * speedup / threads << "% per thread), clear rate " << 100.0 * stats.ClearRate()
+                      << "%, " << stats.ballsLost << " balls lost" << (match ? "" : " MISMATCH") << std::endl;
+        }
+        return deterministic ? 0 : 1;
+    }
+
+    /**
+     * @brief Steps 256 copies of scene1 in lockstep on 1 to N threads with a policy that reads the observations.
+     *
+     * Reports environment steps per second and checks that every thread count produces the
+     * same observations, rewards and episode ends. Every fourth environment holds left and loses
+     * its ball, the rest track it until the step limit, so both game over and truncation reset
+     * environments during the run.
+     */
+    int BenchVectorEnv()
+    {
+        VectorEnvOptions options;
+        options.envCount = 256;
+        options.maxEpisodeSteps = 600;
+        options.seed = 42;
+        const int steps = 5000;
+
+        const unsigned maxThreads = std::max(JobSystem::DefaultThreadCount(), 4u);
+        std::cout << options.envCount << " environments of " << options.scene << ", " << steps << " steps ("
+                  << JobSystem::DefaultThreadCount() << " hardware threads)" << std::endl;
+
+        uint64_t expectedHash = 0;
+        double singleRate = 0;
+        bool deterministic = true;
+        bool resetsSeen = true;
+        for (unsigned threads = 1; threads <= maxThreads; threads *= 2)
+        {
+            VectorEnv envs(options);
+            if (!envs.Init())
+                return 1;
+            const size_t n = envs.GetEnvCount();
+            std::vector<float> balls(n * options.maxBalls * 4), paddleX(n), rewards(n);
+            std::vector<uint32_t> ballCounts(n);
+            std::vector<uint64_t> brickMasks(n * envs.BrickMaskWords());
+            std::vector<uint8_t> dones(n), actions(n);
+            EnvBuffers buffers{balls.data(), ballCounts.data(), paddleX.data(), brickMasks.data(), rewards.data(), dones.data()};
+            envs.Reset(buffers);
+
+            JobSystem jobs(threads);
+            double totalReward = 0;
+            size_t episodes = 0, gameOvers = 0, truncations = 0;
+            // FNV-1a over every buffer after every step.
+            uint64_t hash = 1469598103934665603ull;
+            auto mix = [&hash](const void *data, size_t size)
+            {
+                const unsigned char *bytes = static_cast<const unsigned char *>(data);
+                for (size_t i = 0; i < size; ++i)
+                    hash = (hash ^ bytes[i]) * 1099511628211ull;
+            };
+            double seconds = 0;
+            for (int step = 0; step < steps; ++step)
+            {
+                // Steer the paddle's centre (paddle width 64) under the first ball.
+                for (size_t env = 0; env < n; ++env)
+                {
+                    if (env % 4 == 0)
+                    {
+                        actions[env] = kButtonLeft;
+                        continue;
+                    }
+                    const float target = ballCounts[env] ? balls[env * options.maxBalls * 4] : 800.0f;
+                    const float centre = paddleX[env] + 32.0f;
+                    actions[env] = target < centre - 16.0f ? kButtonLeft : (target > centre + 16.0f ? kButtonRight : 0);
+                }
+                Uint64 start = SDL_GetPerformanceCounter();
+                envs.Step(actions.data(), buffers, jobs);
+                seconds += SecondsSince(start);
+                for (size_t env = 0; env < n; ++env)
+                {
+                    totalReward += rewards[env];
+                    episodes += dones[env] != kEnvRunning;
+                    gameOvers += dones[env] == kEnvGameOver;
+                    truncations += dones[env] == kEnvTruncated;
+                }
+                mix(balls.data(), balls.size() * sizeof(float));
+                mix(paddleX.data(), paddleX.size() * sizeof(float));
+                mix(brickMasks.data(), brickMasks.size() * sizeof(uint64_t));
+                mix(rewards.data(), rewards.size() * sizeof(float));
+                mix(dones.data(), dones.size());
+            }
+
+            double rate = static_cast<double>(n) * steps / seconds;
+            if (threads == 1)
+            {
+                expectedHash = hash;
+                singleRate = rate;
+            }
+            bool match = hash == expectedHash;
+            deterministic = deterministic && match;
+            // Both reset paths must run, or the hash says nothing about them.
+            resetsSeen = resetsSeen && gameOvers > 0 && truncations > 0;
+            std::cout << "  " << threads << " thread(s): " << rate << " env steps/s, speedup " << rate / singleRate
+                      << "x, reward " << totalReward << ", " << episodes << " episode(s) ended (" << gameOvers
+                      << " game over, " << truncations << " truncated), buffer hash " << std::hex << hash
+                      << std::dec << (match ? "" : " MISMATCH") << std::endl;
+        }
+        return deterministic && resetsSeen ? 0 : 1;
+    }
+
+    /**
+     * @brief Steps scene3 with thousands of balls on 1 to N threads and checks the results match.
+     *
+     * Every run uses the same seed and must end with the same Scene::StateHash(), so the
+     * parallel narrow phase is verified to be independent of the thread count.
+     */
+    int BenchThreads()
+    {
+        const int ballCount = 8192;
+        const int frames = 300;
+        const unsigned maxThreads = std::max(JobSystem::DefaultThreadCount(), 4u);
+
+        std::cout << "scene3 with " << ballCount << " balls, " << frames << " frames ("
+                  << JobSystem::DefaultThreadCount() << " hardware threads)" << std::endl;
+
+        uint64_t expectedHash = 0;
+        double singleSeconds = 0;
+        bool deterministic = true;
+        for (unsigned threads = 1; threads <= maxThreads; threads *= 2)
+        {
+            JobSystem jobs(threads);
+            Scene scene;
+            scene.LoadFromFile("../Scenes/scene3.txt", nullptr);
+            scene.SetJobSystem(&jobs);
+            for (int i = 0; i < ballCount; ++i)
+            {
+                float x = static_cast<float>((i * 37) % 1580);
+                float y = 350.0f + static_cast<float>((i * 11) % 500);
+                scene.SpawnBall(x, y, (i % 2 ? 180.0f : -180.0f), static_cast<float>(i % 3 - 1) * 25.0f);
+            }
+
+            scene.SetSeed(42);
+            Uint64 start = SDL_GetPerformanceCounter();
+            int frame = 0;
+            for (; frame < frames && scene.GetSceneStatus(); ++frame)
+                scene.Update(1.0f / 60.0f);
+            double seconds = SecondsSince(start);
+            uint64_t hash = scene.StateHash();
+
+            if (threads == 1)
+            {
+                expectedHash = hash;
+                singleSeconds = seconds;
+            }
+            bool match = hash == expectedHash;
+            deterministic = deterministic && match;
+            std::cout << "  " << threads << " thread(s): " << frame << " frames, " << seconds * 1000.0 / frame << " ms/frame, speedup "
+                      << singleSeconds / seconds << "x, state hash " << std::hex << hash << std::dec
+                      << (match ? "" : " MISMATCH") << std::endl;
+        }
+        return deterministic ? 0 : 1;
+    }
+
+    /**
+     * @brief Writes a closed box of unbreakable bricks with a dense field inside, for the CCD benchmark.
+     */
+    bool WriteDenseBrickScene(const std::string &path)
+    {
+        std::ofstream out(path);
+        out << "PADDLE 700 900\n";
+        out << "BRICK 0 980\n"; // out of reach below the floor, so the level never counts as cleared
+        for (int x = 0; x < 1600; x += 48)
+            out << "UNBRICK " << x << " 950\n";
+        for (int y = 100; y <= 700; y += 60)
+        {
+            for (int x = 48; x < 1500; x += 96)
+                out << "UNBRICK " << x << " " << y << "\n";
+        }
+        return static_cast<bool>(out);
+    }
+
+    /**
+     * @brief Bounces fast balls around a dense field of unbreakable bricks and reports contacts per second.
+     *
+     * The field is closed by a floor of bricks, so any ball that leaves the screen has tunnelled
+     * through it; the run fails if one does. A short and a very long timestep are both tested.
+     */
+    int BenchCollisions()
+    {
+        const std::string scenePath = "bench_dense_scene.txt";
+        const int ballCount = 1024;
+        const float speed = 2000.0f;
+        const double simulatedSeconds = 10.0;
+
+        if (!WriteDenseBrickScene(scenePath))
+        {
+            std::cerr << "Could not write " << scenePath << std::endl;
+            return 1;
+        }
+
+        bool tunnelled = false;
+        for (float dt : {1.0f / 60.0f, 1.0f / 10.0f})
+        {
+            Scene scene;
+            scene.LoadFromFile(scenePath, nullptr);
+            for (int i = 0; i < ballCount; ++i)
+            {
+                float angle = static_cast<float>(i) * 2.39996f; // golden angle spreads the directions
+                scene.SpawnBall(60.0f + static_cast<float>((i * 53) % 1480), 760.0f + static_cast<float>((i * 7) % 150),
+                                speed * std::cos(angle), speed * std::sin(angle));
+            }
+            const size_t entities = scene.GetEntityCount();
+
+            const int steps = static_cast<int>(simulatedSeconds / dt);
+            Uint64 start = SDL_GetPerformanceCounter();
+            for (int i = 0; i < steps; ++i)
+                scene.Update(dt);
+            double seconds = SecondsSince(start);
+
+            size_t lost = entities - scene.GetEntityCount();
+            tunnelled = tunnelled || lost > 0;
+            std::cout << "dense field, " << ballCount << " balls at " << speed << " px/s, dt " << dt << "s, "
+                      << steps << " steps" << std::endl;
+            std::cout << "  " << scene.GetCollisionCount() << " contacts in " << seconds << "s: "
+                      << scene.GetCollisionCount() / seconds << " contacts/s, balls escaped: " << lost << std::endl;
+        }
+
+        std::remove(scenePath.c_str());
+        return tunnelled ? 1 : 0;
+    }
+
+    /**
+     * @brief Checks every OverlapBatch() kernel against SDL_HasIntersectionF() and times them.
+     *
+     * The check uses random rectangles on a coarse half-pixel grid, so shared edges, containment
+     * and empty or negative sizes come up often, and batch sizes that leave a remainder after
+     * the vector loop. The timing tests one box against 4096 boxes, as the paddle is tested
+     * against the drops. Fails on any disagreement.
+     */
+    int BenchAABB()
+    {
+        const size_t batchSize = 4096;
+        const int checkRounds = 500;
+        const int timeRounds = 20000;
+
+        srand(7);
+        auto randomRect = []()
+        {
+            return SDL_FRect{static_cast<float>(rand() % 64) * 0.5f, static_cast<float>(rand() % 64) * 0.5f,
+                             static_cast<float>(rand() % 24 - 2) * 0.5f, static_cast<float>(rand() % 24 - 2) * 0.5f};
+        };
+        std::vector<SDL_FRect> rects(batchSize);
+        for (auto &rect : rects)
+            rect = randomRect();
+
+        const AABBKernel kernels[] = {AABBKernel::Scalar, AABBKernel::SSE2, AABBKernel::AVX2};
+        std::vector<uint32_t> expected, found(batchSize);
+        bool agree = true;
+        size_t overlaps = 0;
+        for (size_t size = batchSize - 8; size <= batchSize; ++size)
+        {
+            AABBBatch batch;
+            for (size_t i = 0; i < size; ++i)
+                batch.Push(rects[i]);
+            for (int round = 0; round < checkRounds; ++round)
+            {
+                SDL_FRect box = randomRect();
+                expected.clear();
+                for (size_t i = 0; i < size; ++i)
+                {
+                    if (SDL_HasIntersectionF(&box, &rects[i]))
+                        expected.push_back(static_cast<uint32_t>(i));
+                }
+                overlaps += expected.size();
+                for (AABBKernel kernel : kernels)
+                {
+                    if (!IsAABBKernelSupported(kernel))
+                        continue;
+                    size_t count = OverlapBatch(box, batch, found.data(), kernel);
+                    if (count != expected.size() || !std::equal(expected.begin(), expected.end(), found.begin()))
+                    {
+                        std::cerr << AABBKernelName(kernel) << " disagrees with SDL_HasIntersectionF for box {" << box.x << ", "
+                                  << box.y << ", " << box.w << ", " << box.h << "} over " << size << " boxes" << std::endl;
+                        agree = false;
+                    }
+                }
+            }
+        }
+        std::cout << "correctness: " << 9 * checkRounds << " boxes against 4088-4096 boxes each, " << overlaps
+                  << " overlaps, " << (agree ? "all kernels agree" : "MISMATCH") << std::endl;
+
+        AABBBatch batch;
+        for (const auto &rect : rects)
+            batch.Push(rect);
+        const double tests = static_cast<double>(batchSize) * timeRounds;
+
+        size_t sdlHits = 0;
+        Uint64 start = SDL_GetPerformanceCounter();
+        for (int round = 0; round < timeRounds; ++round)
+        {
+            SDL_FRect box = rects[round % batchSize];
+            for (const auto &rect : rects)
+                sdlHits += SDL_HasIntersectionF(&box, &rect) ? 1 : 0;
+        }
+        double sdlSeconds = SecondsSince(start);
+        std::cout << "SDL_HasIntersectionF: " << sdlSeconds * 1e9 / tests << " ns/test (" << sdlHits << " hits)" << std::endl;
+
+        for (AABBKernel kernel : kernels)
+        {
+            if (!IsAABBKernelSupported(kernel))
+            {
+                std::cout << AABBKernelName(kernel) << ": not supported" << std::endl;
+                continue;
+            }
+            size_t hits = 0;
+            start = SDL_GetPerformanceCounter();
+            for (int round = 0; round < timeRounds; ++round)
+                hits += OverlapBatch(rects[round % batchSize], batch, found.data(), kernel);
+            double seconds = SecondsSince(start);
+            std::cout << AABBKernelName(kernel) << ": " << seconds * 1e9 / tests << " ns/test (" << hits << " hits), "
+                      << sdlSeconds / seconds << "x SDL_HasIntersectionF" << (kernel == BestAABBKernel() ? " [default]" : "") << std::endl;
+        }
+        return agree ? 0 : 1;
+    }
+
+    /**
+     * @brief Loads a generated level with 200k bricks from text and from the binary format.
+     *
+     * Both loads must produce the same scene; the run fails if they do not.
+     */
+    int BenchSceneLoad()
+    {
+        const std::string textPath = "bench_big_scene.txt";
+        const std::string binaryPath = "bench_big_scene.bscene";
+        const int columns = 500;
+        const int rows = 400;
+        {
+            std::ofstream out(textPath);
+            out << "PADDLE 700 900\n";
+            out << "BALL 800 850 70 -70\n";
+            for (int row = 0; row < rows; ++row)
+            {
+                for (int col = 0; col < columns; ++col)
+                    out << ((row + col) % 7 ? "BRICK " : "UNBRICK ") << col * 45 << " " << 100 + row * 22 << "\n";
+            }
+            if (!out)
+            {
+                std::cerr << "Could not write " << textPath << std::endl;
+                return 1;
+            }
+        }
+
+        Uint64 start = SDL_GetPerformanceCounter();
+        bool converted = ConvertScene(textPath, binaryPath);
+        double convertSeconds = SecondsSince(start);
+
+        uint64_t hashes[2] = {};
+        size_t entities[2] = {};
+        double seconds[2] = {};
+        const std::string paths[2] = {textPath, binaryPath};
+        for (int i = 0; i < 2 && converted; ++i)
+        {
+            Scene scene;
+            start = SDL_GetPerformanceCounter();
+            scene.LoadFromFile(paths[i], nullptr);
+            seconds[i] = SecondsSince(start);
+            entities[i] = scene.GetEntityCount();
+            hashes[i] = scene.StateHash();
+        }
+        std::remove(textPath.c_str());
+        std::remove(binaryPath.c_str());
+        if (!converted)
+            return 1;
+
+        bool same = entities[0] == entities[1] && hashes[0] == hashes[1];
+        std::cout << columns * rows << " bricks: converted in " << convertSeconds << "s" << std::endl;
+        std::cout << "  text load:   " << seconds[0] << "s, " << entities[0] << " entities" << std::endl;
+        std::cout << "  binary load: " << seconds[1] << "s, " << entities[1] << " entities, "
+                  << seconds[0] / seconds[1] << "x faster" << (same ? "" : " MISMATCH") << std::endl;
+        return same ? 0 : 1;
+    }
+
+    /**
+     * @brief The text scene parser as it was before ParseSceneText() parsed in place: one
+     * std::getline, std::istringstream and stream extraction per line. Kept as a reference.
+     */
+    void ParseSceneTextStreams(const std::string &path, SceneData &data)
+    {
+        data = SceneData{};
+        std::ifstream infile(path);
+        std::string line;
+        while (std::getline(infile, line))
+        {
+            if (line.empty() || line[0] == '#')
+                continue;
+            std::istringstream iss(line);
+            std::string entityType;
+            iss >> entityType;
+            if (entityType == "PADDLE")
+            {
+                ScenePaddleRecord paddle;
+                if (iss >> paddle.x >> paddle.y)
+                    data.paddles.push_back(paddle);
+            }
+            else if (entityType == "BALL")
+            {
+                SceneBallRecord ball;
+                if (iss >> ball.x >> ball.y >> ball.velX >> ball.velY)
+                    data.balls.push_back(ball);
+            }
+            else if (entityType == "BRICK" || entityType == "UNBRICK")
+            {
+                SceneBrickRecord brick;
+                if (iss >> brick.x >> brick.y)
+                {
+                    brick.unbreakable = entityType == "UNBRICK" ? 1 : 0;
+                    data.bricks.push_back(brick);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Parses a generated 1M-line text scene with ParseSceneText() and with the old
+     * stream-based parser, and checks the diagnostics of a scene with known mistakes.
+     *
+     * Fails if the two parsers disagree, if the in-place parse of the mapped file takes
+     * 100ms or more, or if a diagnostic is missing or misplaced.
+     */
+    int BenchSceneParse()
+    {
+        const std::string path = "bench_parse_scene.txt";
+        const int lines = 1000000;
+        {
+            std::ofstream out(path, std::ios::binary);
+            out << "# generated\nPADDLE 700 900\nBALL 800.5 850 70 -70.25\n";
+            for (int i = 3; i < lines; ++i)
+            {
+                if (i % 1000 == 0)
+                    out << "# row " << i / 1000 << "\r\n";
+                else
+                    out << (i % 7 ? "BRICK " : "UNBRICK ") << (i % 1000) * 1.5f << " " << 100 + (i / 1000) * 0.25f << (i % 3 ? "\n" : "\r\n");
+            }
+            if (!out)
+            {
+                std::cerr << "Could not write " << path << std::endl;
+                return 1;
+            }
+        }
+
+        SceneData parsed, reference;
+        std::vector<SceneDiagnostic> diagnostics;
+        double best = 1e9;
+        for (int run = 0; run < 5; ++run)
+        {
+            Uint64 start = SDL_GetPerformanceCounter();
+            MappedFile mapped;
+            if (!mapped.Open(path))
+                return 1;
+            diagnostics.clear();
+            ParseSceneText(mapped.Data(), mapped.Size(), parsed, diagnostics);
+            best = std::min(best, SecondsSince(start));
+        }
+        Uint64 start = SDL_GetPerformanceCounter();
+        ParseSceneTextStreams(path, reference);
+        const double streams = SecondsSince(start);
+        std::remove(path.c_str());
+
+        auto sameBricks = [](const SceneBrickRecord &a, const SceneBrickRecord &b)
+        { return a.x == b.x && a.y == b.y && a.unbreakable == b.unbreakable; };
+        const bool same = diagnostics.empty() && parsed.paddles.size() == reference.paddles.size() &&
+                          parsed.balls.size() == reference.balls.size() && parsed.balls[0].velY == reference.balls[0].velY &&
+                          std::equal(parsed.bricks.begin(), parsed.bricks.end(), reference.bricks.begin(), reference.bricks.end(), sameBricks);
+
+        const std::string broken = "PADDLE 700\n  BRICK 10 x20\nBRIK 1 2\n\nBALL 1 2 3 4 # fine\nUNBRICK 5 1e99\n";
+        SceneData brokenData;
+        std::vector<SceneDiagnostic> found;
+        ParseSceneText(broken.data(), broken.size(), brokenData, found);
+        const uint32_t expected[4][2] = {{1, 11}, {2, 12}, {3, 1}, {6, 11}};
+        bool located = found.size() == 4 && brokenData.balls.size() == 1;
+        for (size_t i = 0; located && i < 4; ++i)
+            located = found[i].line == expected[i][0] && found[i].column == expected[i][1];
+        for (const SceneDiagnostic &diagnostic : found)
+            std::cout << "  line " << diagnostic.line << ", column " << diagnostic.column << ": " << diagnostic.message << std::endl;
+
+        std::cout << lines << " lines, " << parsed.bricks.size() << " bricks" << std::endl;
+        std::cout << "  mapped, in place: " << best * 1000.0 << " ms (best of 5)" << std::endl;
+        std::cout << "  getline/istringstream: " << streams * 1000.0 << " ms, " << streams / best << "x slower"
+                  << (same ? "" : " MISMATCH") << std::endl;
+        if (!located)
+            std::cerr << "diagnostics missing or misplaced" << std::endl;
+        return same && located && best < 0.1 ? 0 : 1;
+    }
+
+    /**
+     * @brief Loads 200k-brick levels written one brick per line and written with brick
+     * directives (one BRICKGRID line; BRICKMASK lines for a checkerboard), and compares the
+     * file sizes and load times.
+     *
+     * Both forms of each level must load into the same scene; the run fails if they do not.
+     */
+    int BenchSceneDirectives()
+    {
+        const int cols = 512, rows = 400;
+        const std::string linesPath = "bench_lines_scene.txt";
+        const std::string directivesPath = "bench_directives_scene.txt";
+        bool ok = true;
+
+        for (int pattern = 0; pattern < 2; ++pattern)
+        {
+            {
+                std::ofstream lines(linesPath), directives(directivesPath);
+                lines << "PADDLE 700 900\nBALL 800 850 70 -70\n";
+                directives << "PADDLE 700 900\nBALL 800 850 70 -70\n";
+                if (pattern == 0)
+                {
+                    directives << "BRICKGRID 0 100 3 2 " << cols << " " << rows << "\n";
+                    for (int row = 0; row < rows; ++row)
+                        for (int col = 0; col < cols; ++col)
+                            lines << "BRICK " << col * 3 << " " << 100 + row * 2 << "\n";
+                }
+                else
+                {
+                    // Columns in chunks of 64, each chunk one BRICKMASK line holding every row.
+                    for (int chunk = 0; chunk < cols / 64; ++chunk)
+                    {
+                        directives << "BRICKMASK " << chunk * 192 << " 100 3 2";
+                        for (int row = 0; row < rows; ++row)
+                        {
+                            directives << (row % 2 ? " 0xAAAAAAAAAAAAAAAA" : " 0x5555555555555555");
+                            for (int col = row % 2; col < 64; col += 2)
+                                lines << "BRICK " << chunk * 192 + col * 3 << " " << 100 + row * 2 << "\n";
+                        }
+                        directives << "\n";
+                    }
+                }
+                if (!lines || !directives)
+                {
+                    std::cerr << "Could not write the generated scenes" << std::endl;
+                    return 1;
+                }
+            }
+
+            const std::string paths[2] = {linesPath, directivesPath};
+            uint64_t hashes[2] = {};
+            size_t bricks[2] = {}, bytes[2] = {};
+            double seconds[2] = {};
+            for (int i = 0; i < 2; ++i)
+            {
+                std::ifstream in(paths[i], std::ios::binary | std::ios::ate);
+                bytes[i] = static_cast<size_t>(in.tellg());
+                Scene scene;
+                Uint64 start = SDL_GetPerformanceCounter();
+                scene.LoadFromFile(paths[i], nullptr);
+                seconds[i] = SecondsSince(start);
+                bricks[i] = scene.GetBrickCount();
+                hashes[i] = scene.StateHash();
+            }
+            std::remove(linesPath.c_str());
+            std::remove(directivesPath.c_str());
+
+            const bool same = bricks[0] == bricks[1] && hashes[0] == hashes[1];
+            ok = ok && same;
+            std::cout << (pattern == 0 ? "full grid, " : "checkerboard, ") << bricks[0] << " bricks" << std::endl;
+            std::cout << "  one line per brick: " << bytes[0] << " bytes, loaded in " << seconds[0] * 1000.0 << " ms" << std::endl;
+            std::cout << "  " << (pattern == 0 ? "BRICKGRID" : "BRICKMASK") << ":          " << bytes[1] << " bytes, loaded in "
+                      << seconds[1] * 1000.0 << " ms (" << bytes[0] / std::max<size_t>(bytes[1], 1) << "x smaller)"
+                      << (same ? "" : " MISMATCH") << std::endl;
+        }
+        return ok ? 0 : 1;
+    }
+
+    /**
+     * @brief Plays a generated 50-level campaign streamed, then loaded all up front as before.
+     *
+     * Reports the time to the first playable scene and the peak RSS of each approach. The
+     * streamed run mirrors Application: the next scene loads while one plays, and each finished
+     * scene is retired. Levels play far faster here than in a game, so the streamed run also
+     * waits at transitions for loads a real level would hide.
+     * Fails if a level does not load completely.
+     */
+    int BenchStreaming()
+    {
+        const int levels = 50;
+        const int columns = 100;
+        const int rows = 80;
+        const int framesPerLevel = 60;
+
+        std::vector<std::string> paths;
+        for (int level = 0; level < levels; ++level)
+        {
+            paths.push_back("bench_level_" + std::to_string(level) + ".txt");
+            std::ofstream out(paths.back());
+            out << "PADDLE 700 900\n";
+            out << "BALL " << 100 + level * 20 << " 850 70 -70\n";
+            for (int row = 0; row < rows; ++row)
+            {
+                for (int col = 0; col < columns; ++col)
+                    out << ((row + col + level) % 5 ? "BRICK " : "UNBRICK ") << col * 16 << " " << 50 + row * 10 << "\n";
+            }
+        }
+        const size_t bricksPerLevel = static_cast<size_t>(columns) * rows;
+        // The paddle and ball are entities; bricks are too only if the BrickField left them out.
+        auto loadedFully = [bricksPerLevel](const Scene &scene)
+        { return scene.GetBrickCount() == bricksPerLevel && scene.GetEntityCount() == 2 + scene.GetLegacyBrickCount(); };
+        bool complete = true;
+
+        // Keep the per-level log lines out of the report.
+        std::streambuf *log = std::cout.rdbuf();
+        std::ostringstream discard;
+
+        ResetPeakRss();
+        size_t baseRss = CurrentRssBytes();
+        Uint64 start = SDL_GetPerformanceCounter();
+        double streamedFirstFrame = 0.0, waited = 0.0;
+        {
+            std::cout.rdbuf(discard.rdbuf());
+            JobSystem jobs(1);
+            SceneStreamer streamer(&jobs);
+            streamer.Request(paths[0]);
+            std::unique_ptr<Scene> scene;
+            for (int level = 0; level < levels; ++level)
+            {
+                Uint64 takeStart = SDL_GetPerformanceCounter();
+                std::unique_ptr<Scene> next = streamer.Take();
+                next->AttachRenderer(nullptr);
+                if (level == 0)
+                    streamedFirstFrame = SecondsSince(start);
+                else
+                    waited += SecondsSince(takeStart);
+                complete = complete && loadedFully(*next);
+                streamer.Retire(std::move(scene));
+                scene = std::move(next);
+                if (level + 1 < levels)
+                    streamer.Request(paths[level + 1]);
+                for (int frame = 0; frame < framesPerLevel && scene->GetSceneStatus(); ++frame)
+                    scene->Update(1.0f / 60.0f);
+            }
+            std::cout.rdbuf(log);
+        }
+        double streamedTotal = SecondsSince(start);
+        size_t streamedPeak = PeakRssBytes();
+
+        ResetPeakRss();
+        start = SDL_GetPerformanceCounter();
+        double eagerFirstFrame = 0.0;
+        {
+            std::cout.rdbuf(discard.rdbuf());
+            std::vector<std::unique_ptr<Scene>> scenes;
+            for (const std::string &path : paths)
+            {
+                scenes.push_back(std::make_unique<Scene>());
+                scenes.back()->LoadFromFile(path, nullptr);
+                complete = complete && loadedFully(*scenes.back());
+            }
+            eagerFirstFrame = SecondsSince(start);
+            for (auto &scene : scenes)
+            {
+                for (int frame = 0; frame < framesPerLevel && scene->GetSceneStatus(); ++frame)
+                    scene->Update(1.0f / 60.0f);
+            }
+            std::cout.rdbuf(log);
+        }
+        double eagerTotal = SecondsSince(start);
+        size_t eagerPeak = PeakRssBytes();
+
+        for (const std::string &path : paths)
+            std::remove(path.c_str());
+
+        std::cout << levels << " levels of " << columns * rows << " bricks, " << framesPerLevel << " frames each (RSS before: "
+                  << baseRss / 1024 << " KB)" << std::endl;
+        std::cout << "  streamed: first frame after " << streamedFirstFrame * 1000.0 << " ms, waited " << waited * 1000.0
+                  << " ms at transitions, total " << streamedTotal << "s, peak RSS " << streamedPeak / 1024 << " KB" << std::endl;
+        std::cout << "  eager:    first frame after " << eagerFirstFrame * 1000.0 << " ms, total " << eagerTotal
+                  << "s, peak RSS " << eagerPeak / 1024 << " KB" << std::endl;
+        if (!complete)
+            std::cerr << "a level did not load completely" << std::endl;
+        return complete ? 0 : 1;
+    }
+
+    /**
+     * @brief Measures what the hot reload watcher costs the frame thread while idle, then edits a
+     * watched scene file and reports how soon the edit arrives and what applying it changed.
+     *
+     * The edit removes every other brick of the first row and adds a row; the scene's ball
+     * must come through unchanged.
+     */
+    int BenchHotReload()
+    {
+        const std::string path = "bench_hot_reload.txt";
+        auto writeScene = [&](bool edited)
+        {
+            std::ofstream out(path);
+            out << "PADDLE 700 900\nBALL 800 500 70 70\n";
+            for (int r = 0; r < 10; ++r)
+            {
+                for (int c = 0; c < 30; ++c)
+                {
+                    if (!(edited && r == 0 && c % 2 == 0))
+                        out << "BRICK " << 50 + c * 48 << " " << 50 + r * 30 << "\n";
+                }
+            }
+            if (edited)
+            {
+                for (int c = 0; c < 20; ++c)
+                    out << "UNBRICK " << 100 + c * 64 << " " << 400 << "\n";
+            }
+            return static_cast<bool>(out);
+        };
+        if (!writeScene(false))
+            return 1;
+
+        SceneData records;
+        Scene scene;
+        if (!LoadSceneData(path, records))
+            return 1;
+        scene.Load(ViewScene(records), nullptr);
+        scene.Update(1.0f / 60.0f);
+        const size_t bricksBefore = scene.GetBrickCount();
+        const SDL_FRect ballBefore = scene.GetBallStorage().GetRect(0);
+
+        HotReloader watcher;
+        if (!watcher.Start({path}, {}))
+        {
+            std::remove(path.c_str());
+            return 1;
+        }
+
+        const int polls = 10000000;
+        int seen = 0;
+        Uint64 start = SDL_GetPerformanceCounter();
+        for (int i = 0; i < polls; ++i)
+            seen += watcher.HasChanges();
+        const double pollNs = SecondsSince(start) * 1e9 / polls;
+
+        writeScene(true);
+        start = SDL_GetPerformanceCounter();
+        while (!watcher.HasChanges() && SecondsSince(start) < 2.0)
+            SDL_Delay(1);
+        const double latency = SecondsSince(start);
+
+        std::vector<SceneEdit> scenes;
+        std::vector<ImageEdit> images;
+        watcher.Take(scenes, images);
+        size_t added = 0, removed = 0;
+        double applyMs = 0;
+        if (!scenes.empty())
+        {
+            start = SDL_GetPerformanceCounter();
+            scene.ApplyBrickEdits(ViewScene(scenes.back().records), added, removed);
+            applyMs = SecondsSince(start) * 1000.0;
+        }
+        watcher.Stop();
+        std::remove(path.c_str());
+
+        const SDL_FRect ballAfter = scene.GetBallStorage().GetRect(0);
+        const bool ballKept = ballAfter.x == ballBefore.x && ballAfter.y == ballBefore.y;
+        std::cout << "hot reload of a " << bricksBefore << "-brick scene" << std::endl;
+        std::cout << "  idle poll: " << pollNs << " ns, " << seen << " false positives in " << polls << " polls" << std::endl;
+        std::cout << "  edit seen after " << latency * 1000.0 << " ms (including the watcher's settle delay), applied in "
+                  << applyMs << " ms: " << added << " brick(s) added, " << removed << " removed, "
+                  << scene.GetBrickCount() << " bricks now, ball " << (ballKept ? "kept" : "moved") << std::endl;
+        const bool ok = seen == 0 && added == 20 && removed == 15 && scene.GetBrickCount() == bricksBefore + 5 && ballKept;
+        if (!ok)
+            std::cerr << "the edit was not applied as expected" << std::endl;
+        return ok ? 0 : 1;
+    }
+
+    /**
+     * @brief Loads and plays a million-brick level, then a 100k-brick level with bricks in the
+     * BrickField and as one Brick entity each, and compares memory per brick and speed.
+     *
+     * The 100k-brick level must play out identically both ways (same state hash after every
+     * step), and the million bricks must fit in 8 MB of field. RSS growth is only indicative:
+     * a run may reuse memory freed by the one before.
+     */
+    int BenchBrickField()
+    {
+        const std::string path = "bench_brick_field.txt";
+        const int steps = 600;
+        const int balls = 256;
+        auto writeLevel = [&path](int rows)
+        {
+            std::ofstream out(path);
+            out << "PADDLE 700 900\nBALL 800 850 70 -70\n";
+            out << "BRICKGRID 50 50 1.5 " << 750.0f / static_cast<float>(rows) << " 1000 " << rows << "\n";
+            return static_cast<bool>(out);
+        };
+        struct Run
+        {
+            size_t bricks = 0, legacy = 0, fieldBytes = 0, rss = 0;
+            double loadSeconds = 0.0, stepSeconds = 0.0;
+            int steps = 0;
+            uint32_t broken = 0;
+            bool same = true;
+        };
+        auto play = [&path, steps, balls](bool field, const std::vector<uint64_t> *expected, std::vector<uint64_t> *hashes)
+        {
+            Run run;
+            const size_t rssBefore = CurrentRssBytes();
+            Scene scene;
+            scene.SetBrickField(field);
+            Uint64 start = SDL_GetPerformanceCounter();
+            scene.LoadFromFile(path, nullptr);
+            run.loadSeconds = SecondsSince(start);
+            run.rss = CurrentRssBytes() - std::min(rssBefore, CurrentRssBytes());
+            run.bricks = scene.GetBrickCount();
+            run.legacy = scene.GetLegacyBrickCount();
+            run.fieldBytes = scene.GetBrickFieldBytes();
+            scene.SetSeed(1);
+            for (int i = 0; i < balls; ++i)
+                scene.SpawnBall(60.0f + static_cast<float>((i * 53) % 1480), 850.0f, static_cast<float>(i % 17) * 20.0f - 160.0f, -300.0f);
+
+            for (int i = 0; i < steps && scene.GetSceneStatus(); ++i, ++run.steps)
+            {
+                start = SDL_GetPerformanceCounter();
+                scene.Update(1.0f / 60.0f);
+                run.stepSeconds += SecondsSince(start);
+                if (hashes)
+                    hashes->push_back(scene.StateHash());
+                if (expected)
+                    run.same = run.same && static_cast<size_t>(i) < expected->size() && (*expected)[i] == scene.StateHash();
+            }
+            run.broken = scene.GetBricksBroken();
+            return run;
+        };
+        auto report = [](const char *label, const Run &run)
+        {
+            std::cout << "  " << label << run.bricks << " bricks (" << run.legacy << " entities), field " << run.fieldBytes / 1024
+                      << " KB, RSS +" << run.rss / 1024 << " KB (" << static_cast<double>(run.rss) / run.bricks << " B/brick), loaded in "
+                      << run.loadSeconds * 1000.0 << " ms, " << run.broken << " broken in " << run.steps << " steps, "
+                      << run.stepSeconds * 1e6 / std::max(run.steps, 1) << " us/step" << std::endl;
+        };
+
+        // The million-brick level runs first, before freed memory can hide its RSS growth.
+        std::streambuf *log = std::cout.rdbuf();
+        std::ostringstream discard;
+        if (!writeLevel(1000))
+        {
+            std::cerr << "Failed to write " << path << std::endl;
+            return 1;
+        }
+        std::cout.rdbuf(discard.rdbuf());
+        const Run big = play(true, nullptr, nullptr);
+        std::cout.rdbuf(log);
+        std::cout << "1M bricks, " << balls + 1 << " balls" << std::endl;
+        report("BrickField: ", big);
+
+        std::vector<uint64_t> hashes;
+        const bool written = writeLevel(100);
+        std::cout.rdbuf(discard.rdbuf());
+        const Run field = written ? play(true, nullptr, &hashes) : Run();
+        const Run legacy = written ? play(false, &hashes, nullptr) : Run();
+        std::cout.rdbuf(log);
+        std::remove(path.c_str());
+        std::cout << "100k bricks, " << balls + 1 << " balls" << std::endl;
+        report("BrickField: ", field);
+        report("entities:   ", legacy);
+
+        const bool same = written && legacy.same && field.broken == legacy.broken;
+        if (!same)
+            std::cerr << "the BrickField and entity bricks played out differently" << std::endl;
+        const bool compact = big.bricks == 1000000 && big.legacy == 0 && big.fieldBytes < 8 * 1024 * 1024;
+        if (!compact)
+            std::cerr << "the million bricks did not fit in the field" << std::endl;
+        return same && compact ? 0 : 1;
+    }
+
+    /**
+     * @brief Plays a level of 132 breakable and 100k unbreakable bricks, with bricks in the
+     * BrickField and as Brick entities, reading the scene's totals every step.
+     *
+     * Each step, the totals must match a recount (balls in the ball storage, breakable bricks
+     * broken plus left, score from bricks and drops) and be the same in both modes. Reports
+     * the cost of GetStats() against recounting the standing bricks from WriteBrickMask().
+     */
+    int BenchSceneStats()
+    {
+        const std::string path = "bench_scene_stats.txt";
+        const int steps = 1200;
+        const int balls = 64;
+        const size_t breakable = 33 * 4;
+        {
+            std::ofstream out(path);
+            out << "PADDLE 700 900\nBALL 800 850 70 -70\n";
+            out << "BRICKGRID 50 100 45 25 33 4\n";
+            // Off-screen, past the right wall: never hit, but as many bricks as a big level.
+            out << "UNBRICKGRID 2000 100 1.5 1 1000 100\n";
+            if (!out)
+            {
+                std::cerr << "Failed to write " << path << std::endl;
+                return 1;
+            }
+        }
+
+        std::streambuf *log = std::cout.rdbuf();
+        std::ostringstream discard;
+        std::vector<SceneStats> history[2];
+        bool consistent = true;
+        for (int mode = 0; mode < 2; ++mode)
+        {
+            std::cout.rdbuf(discard.rdbuf());
+            Scene scene;
+            scene.SetBrickField(mode == 0);
+            scene.LoadFromFile(path, nullptr);
+            std::cout.rdbuf(log);
+            scene.SetSeed(1);
+            for (int i = 0; i < balls; ++i)
+                scene.SpawnBall(60.0f + static_cast<float>((i * 53) % 1480), 850.0f, static_cast<float>(i % 17) * 20.0f - 160.0f, -300.0f);
+
+            std::vector<uint64_t> mask((scene.GetBrickCount() + 63) / 64);
+            double statsSeconds = 0.0, scanSeconds = 0.0;
+            for (int step = 0; step < steps && scene.GetSceneStatus(); ++step)
+            {
+                scene.Update(1.0f / 60.0f);
+
+                Uint64 start = SDL_GetPerformanceCounter();
+                const SceneStats stats = scene.GetStats();
+                statsSeconds += SecondsSince(start);
+                history[mode].push_back(stats);
+
+                start = SDL_GetPerformanceCounter();
+                scene.WriteBrickMask(mask.data());
+                size_t standing = 0;
+                for (uint64_t word : mask)
+                    standing += std::bitset<64>(word).count();
+                scanSeconds += SecondsSince(start);
+
+                consistent = consistent && stats.balls == scene.GetBallStorage().Size() &&
+                             stats.bricksLeft + stats.bricksBroken == breakable &&
+                             standing == scene.GetBrickCount() - stats.bricksBroken &&
+                             stats.score == 10u * stats.bricksBroken + 25u * stats.dropsCaught;
+            }
+
+            const SceneStats last = history[mode].empty() ? SceneStats() : history[mode].back();
+            const double reads = static_cast<double>(std::max<size_t>(history[mode].size(), 1));
+            std::cout << (mode == 0 ? "BrickField: " : "entities:   ") << scene.GetBrickCount() << " bricks, "
+                      << history[mode].size() << " steps, score " << last.score << " (" << last.bricksBroken << " bricks, "
+                      << last.dropsCaught << " drops), " << last.bricksLeft << " left, " << last.balls << " balls" << std::endl;
+            std::cout << "  GetStats(): " << statsSeconds * 1e9 / reads << " ns/read, mask recount: "
+                      << scanSeconds * 1e9 / reads << " ns/read" << std::endl;
+        }
+        std::remove(path.c_str());
+
+        bool same = history[0].size() == history[1].size();
+        for (size_t i = 0; same && i < history[0].size(); ++i)
+        {
+            const SceneStats &a = history[0][i], &b = history[1][i];
+            same = a.bricksLeft == b.bricksLeft && a.balls == b.balls && a.drops == b.drops && a.score == b.score &&
+                   a.ballsLost == b.ballsLost;
+        }
+        if (!consistent)
+            std::cerr << "a total disagreed with its recount" << std::endl;
+        if (!same)
+            std::cerr << "the BrickField and entity bricks kept different totals" << std::endl;
+        return consistent && same ? 0 : 1;
+    }
+
+    struct BenchmarkEntry
+    {
+        const char *name;
+        int (*run)();
+    };
+
+    const BenchmarkEntry kBenchmarks[] = {
+        {"components", BenchComponentLookup},
+        {"soak-drops", BenchSoakDrops},
+        {"multiball", BenchMultiball},
+        {"render", BenchRender},
+        {"static-layer", BenchStaticLayer},
+        {"pacer", BenchPacer},
+        {"profiler", BenchProfiler},
+        {"threads", BenchThreads},
+        {"collisions", BenchCollisions},
+        {"aabb", BenchAABB},
+        {"scene-load", BenchSceneLoad},
+        {"scene-parse", BenchSceneParse},
+        {"scene-directives", BenchSceneDirectives},
+        {"streaming", BenchStreaming},
+        {"batch", BenchBatch},
+        {"vecenv", BenchVectorEnv},
+        {"hot-reload", BenchHotReload},
+        {"brick-field", BenchBrickField},
+        {"scene-stats", BenchSceneStats},
+    };
+}
+
+/**
+ * @brief Runs a named engine micro-benchmark and prints its results.
+ *
+ * Benchmarks run headless (no window or renderer) and are selected from the
+ * command line with --bench NAME. An unknown name lists the available ones.
+ *
+ * @param name The benchmark to run.
+ * @return int Exit status code: 0 on success, non-zero on failure or unknown name.
+ */
+int RunBenchmark(const std::string &name)
+{
+    for (const auto &entry : kBenchmarks)
+    {
+        if (name == entry.name)
+            return entry.run();
+    }
+
+    std::cerr << "Unknown benchmark: " << name << ". Available:";
+    for (const auto &entry : kBenchmarks)
+        std::cerr << " " << entry.name;
+    std::cerr << std::endl;
+    return 1;
+}
@@ -0,0 +1,8 @@
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+#include <string>
+
+int RunBenchmark(const std::string &name);
+
+#endif
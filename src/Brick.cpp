@@ -6,14 +6,15 @@
 /**
  * @brief Constructs a new Brick object.
  *
- * Initializes the brick by calling the base GameEntity constructor and sets the brick to active.
+ * Initializes the brick by calling the base GameEntity constructor. The brick starts active once
+ * initComponents() has given it a storage row.
  *
  * @param renderer The SDL_Renderer used for texture creation.
  * @param texturePath The path to the brick texture file.
  * @param speed The base speed value for the brick (default is 0.0f).
  */
 Brick::Brick(SDL_Renderer *renderer, const char *texturePath, float speed)
-    : GameEntity(renderer, texturePath, speed), active(true)
+    : GameEntity(renderer, texturePath, speed)
 {
 }
 
@@ -26,7 +27,7 @@ Brick::Brick(SDL_Renderer *renderer, const char *texturePath, float speed)
  */
 void Brick::Render(SDL_Renderer *renderer)
 {
-    if (!active)
+    if (!IsActive())
         return;
     GameEntity::Render(renderer);
 }
@@ -40,7 +41,7 @@ void Brick::Render(SDL_Renderer *renderer)
  */
 void Brick::Update(float deltaTime)
 {
-    auto coll = GetComponent<Collision2DComponent>(ComponentType::Collision2DComponent);
+    auto coll = GetComponent<Collision2DComponent>();
     if (coll)
     {
         coll->Update(deltaTime);
@@ -9,6 +9,7 @@
  * The Brick class inherits from GameEntity and provides functionality for rendering,
  * updating its collision component, and handling its "active" state (i.e. whether it is broken).
  * An unbreakable brick will ignore attempts to set its state to inactive.
+ * The active flag lives in the brick's ArchetypeStorage row so rendering can skip broken bricks in a sweep.
  */
 class Brick : public GameEntity
 {
@@ -24,7 +25,7 @@ public:
      *
      * @return true if the brick is active, false otherwise.
      */
-    bool IsActive() const { return active; }
+    bool IsActive() const { return mStorage->mActive[StorageRow()] != 0; }
 
     /**
      * @brief Sets the brick's active state.
@@ -36,7 +37,7 @@ public:
     virtual void SetActive(bool a)
     {
         if (!unbreakable)
-            active = a;
+            mStorage->mActive[StorageRow()] = a ? 1 : 0;
     }
 
     /**
@@ -54,7 +55,6 @@ public:
     void SetUnbreakable(bool flag) { unbreakable = flag; }
 
 private:
-    bool active;
     bool unbreakable = false;
 };
 
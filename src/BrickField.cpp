@@ -0,0 +1,296 @@
+#include "BrickField.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+    /**
+     * @brief Returns the coordinate of a lattice line. Build() and CellOf() both go through
+     * it, so a brick accepted on the lattice is placed at exactly its recorded position.
+     */
+    float LatticeCoord(float ref, long index, float pitch)
+    {
+        return ref + static_cast<float>(index) * pitch;
+    }
+
+    /**
+     * @brief Finds the lattice line a coordinate lies exactly on.
+     *
+     * @return bool False if the coordinate falls between lines.
+     */
+    bool LatticeIndex(float value, float ref, float pitch, long &index)
+    {
+        const float steps = std::nearbyint((value - ref) / pitch);
+        if (!(std::fabs(steps) < 1e7f))
+            return false;
+        index = static_cast<long>(steps);
+        return LatticeCoord(ref, index, pitch) == value;
+    }
+}
+
+/**
+ * @brief Removes every brick and the lattice.
+ */
+void BrickField::Clear()
+{
+    mCells.clear();
+    mColX.clear();
+    mRowY.clear();
+    mCols = 0;
+    mRows = 0;
+    mBrickCount = 0;
+    mAliveBreakable = 0;
+}
+
+/**
+ * @brief Works out the lattice the bricks lie on and fills it.
+ *
+ * The pitch is the smallest step between consecutive bricks along a row and between rows
+ * (defaulting to the brick size), anchored at the first brick. Bricks whose position is
+ * exactly on the lattice become cells; the others are returned in offLattice. If the bricks
+ * are so sparse that the lattice would need more than four cells per brick (and over 64k
+ * cells), no field is built and every brick is returned.
+ *
+ * @param records The brick records, in scene file order.
+ * @param count The number of records.
+ * @param brickW The width of every brick.
+ * @param brickH The height of every brick.
+ * @param unbreakableFits Whether unbreakable bricks have the same size; if not, they are all returned.
+ * @param offLattice Receives the indices of the records left out of the field, in order.
+ */
+void BrickField::Build(const SceneBrickRecord *records, size_t count, float brickW, float brickH, bool unbreakableFits,
+                       std::vector<uint32_t> &offLattice)
+{
+    Clear();
+    offLattice.clear();
+    mBrickW = brickW;
+    mBrickH = brickH;
+    mUnbreakableFits = unbreakableFits;
+    auto leaveAllOut = [&]()
+    {
+        Clear();
+        offLattice.clear();
+        for (size_t i = 0; i < count; ++i)
+            offLattice.push_back(static_cast<uint32_t>(i));
+    };
+    if (count == 0 || !(brickW > 0.0f) || !(brickH > 0.0f))
+        return leaveAllOut();
+
+    float pitchX = INFINITY, pitchY = INFINITY;
+    for (size_t i = 1; i < count; ++i)
+    {
+        const float stepX = records[i].x - records[i - 1].x;
+        const float stepY = records[i].y - records[i - 1].y;
+        if (stepY == 0.0f && stepX > 0.0f)
+            pitchX = std::min(pitchX, stepX);
+        else if (stepY != 0.0f)
+            pitchY = std::min(pitchY, std::fabs(stepY));
+    }
+    mPitchX = std::isfinite(pitchX) ? pitchX : brickW;
+    mPitchY = std::isfinite(pitchY) ? pitchY : brickH;
+    mRefX = records[0].x;
+    mRefY = records[0].y;
+
+    long colMin = 0, colMax = 0, rowMin = 0, rowMax = 0;
+    size_t onLattice = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        long col, row;
+        if ((records[i].unbreakable && !unbreakableFits) || !LatticeIndex(records[i].x, mRefX, mPitchX, col) ||
+            !LatticeIndex(records[i].y, mRefY, mPitchY, row))
+            continue;
+        colMin = onLattice ? std::min(colMin, col) : col;
+        colMax = onLattice ? std::max(colMax, col) : col;
+        rowMin = onLattice ? std::min(rowMin, row) : row;
+        rowMax = onLattice ? std::max(rowMax, row) : row;
+        ++onLattice;
+    }
+    const uint64_t cols = static_cast<uint64_t>(colMax - colMin + 1);
+    const uint64_t rows = static_cast<uint64_t>(rowMax - rowMin + 1);
+    if (onLattice == 0 || cols * rows > std::max<uint64_t>(4 * onLattice, 65536) || cols * rows > INT32_MAX)
+        return leaveAllOut();
+
+    mCols = static_cast<int>(cols);
+    mRows = static_cast<int>(rows);
+    mColMin = static_cast<int>(colMin);
+    mRowMin = static_cast<int>(rowMin);
+    mCells.assign(static_cast<size_t>(cols * rows), 0);
+    mColX.resize(mCols);
+    mRowY.resize(mRows);
+    for (int col = 0; col < mCols; ++col)
+        mColX[col] = LatticeCoord(mRefX, col + mColMin, mPitchX);
+    for (int row = 0; row < mRows; ++row)
+        mRowY[row] = LatticeCoord(mRefY, row + mRowMin, mPitchY);
+
+    for (size_t i = 0; i < count; ++i)
+    {
+        uint32_t cell;
+        if (!Place(records[i].x, records[i].y, records[i].unbreakable != 0, cell))
+            offLattice.push_back(static_cast<uint32_t>(i));
+    }
+}
+
+/**
+ * @brief Finds the cell whose brick would sit exactly at a position.
+ *
+ * @return bool False if the position is off the lattice or outside the field.
+ */
+bool BrickField::CellOf(float x, float y, uint32_t &cell) const
+{
+    long col, row;
+    if (mCells.empty() || !LatticeIndex(x, mRefX, mPitchX, col) || !LatticeIndex(y, mRefY, mPitchY, row))
+        return false;
+    col -= mColMin;
+    row -= mRowMin;
+    if (col < 0 || col >= mCols || row < 0 || row >= mRows)
+        return false;
+    cell = static_cast<uint32_t>(row * mCols + col);
+    return true;
+}
+
+/**
+ * @brief Fills an empty cell with a new, unbroken brick.
+ */
+void BrickField::SetBrick(uint32_t cell, bool unbreakable)
+{
+    mCells[cell] = kPresent | kAlive | (unbreakable ? kUnbreakable : static_cast<uint8_t>(1 << kHitShift));
+    ++mBrickCount;
+    if (!unbreakable)
+        ++mAliveBreakable;
+}
+
+/**
+ * @brief Adds a brick at a position, if the position is a free cell of the lattice.
+ *
+ * @param x The brick's left edge.
+ * @param y The brick's top edge.
+ * @param unbreakable Whether the brick is unbreakable.
+ * @param cell Receives the brick's cell.
+ * @return bool False if the brick cannot be part of the field; the caller keeps it as an entity.
+ */
+bool BrickField::Place(float x, float y, bool unbreakable, uint32_t &cell)
+{
+    if ((unbreakable && !mUnbreakableFits) || !CellOf(x, y, cell) || IsPresent(cell))
+        return false;
+    SetBrick(cell, unbreakable);
+    return true;
+}
+
+/**
+ * @brief Empties a cell, e.g. when a scene edit deletes its brick.
+ *
+ * @param cell The cell.
+ */
+void BrickField::Remove(uint32_t cell)
+{
+    if (!IsPresent(cell))
+        return;
+    if (IsAlive(cell) && !IsUnbreakable(cell))
+        --mAliveBreakable;
+    --mBrickCount;
+    mCells[cell] = 0;
+}
+
+/**
+ * @brief Takes one hit off a breakable brick.
+ *
+ * @param cell The cell hit.
+ * @return bool True if the hit broke the brick; false if it was already broken, is
+ * unbreakable or has hits left.
+ */
+bool BrickField::Hit(uint32_t cell)
+{
+    uint8_t &state = mCells[cell];
+    if (!(state & kAlive) || (state & kUnbreakable))
+        return false;
+    if (((state & kHitMask) >> kHitShift) > 1)
+    {
+        state = static_cast<uint8_t>(state - (1 << kHitShift));
+        return false;
+    }
+    state = static_cast<uint8_t>(state & ~(kAlive | kHitMask));
+    --mAliveBreakable;
+    return true;
+}
+
+/**
+ * @brief Collects the unbroken bricks that may overlap a rectangle.
+ *
+ * Only the cells in the rectangle's column and row range (widened by a brick and a cell,
+ * so touching bricks are included) are looked at, whatever the number of bricks.
+ *
+ * @param rect The area, e.g. a ball's swept path.
+ * @param out Receives the cells, in ascending order, replacing its contents.
+ */
+void BrickField::Query(const SDL_FRect &rect, std::vector<uint32_t> &out) const
+{
+    out.clear();
+    if (mCells.empty())
+        return;
+    auto range = [](float low, float high, float origin, float pitch, int count, int &first, int &last)
+    {
+        const float from = std::floor((low - origin) / pitch) - 1.0f;
+        const float to = std::floor((high - origin) / pitch) + 1.0f;
+        if (!(to >= 0.0f) || !(from <= static_cast<float>(count - 1)))
+            return false;
+        first = static_cast<int>(std::max(from, 0.0f));
+        last = static_cast<int>(std::min(to, static_cast<float>(count - 1)));
+        return true;
+    };
+    int col0, col1, row0, row1;
+    if (!range(rect.x - mBrickW, rect.x + rect.w, mColX[0], mPitchX, mCols, col0, col1) ||
+        !range(rect.y - mBrickH, rect.y + rect.h, mRowY[0], mPitchY, mRows, row0, row1))
+        return;
+    for (int row = row0; row <= row1; ++row)
+    {
+        const uint32_t base = static_cast<uint32_t>(row) * static_cast<uint32_t>(mCols);
+        for (int col = col0; col <= col1; ++col)
+        {
+            if (mCells[base + col] & kAlive)
+                out.push_back(base + col);
+        }
+    }
+}
+
+/**
+ * @brief Queues every unbroken brick's sprite and collision outline.
+ *
+ * @param queue The render queue.
+ * @param layer The layer for the sprites.
+ * @param debugLayer The layer for the collision outlines.
+ */
+void BrickField::Render(RenderQueue &queue, uint8_t layer, uint8_t debugLayer) const
+{
+    const ResourceManager &resources = ResourceManager::getInstance();
+    SDL_Texture *const textures[2] = {resources.GetTexture(mBrickTexture), resources.GetTexture(mUnbrickTexture)};
+    const SDL_FRect uvs[2] = {resources.GetUV(mBrickTexture), resources.GetUV(mUnbrickTexture)};
+    const SDL_Color red{255, 0, 0, 255};
+    for (uint32_t cell = 0; cell < mCells.size(); ++cell)
+    {
+        if (!(mCells[cell] & kAlive))
+            continue;
+        const int kind = IsUnbreakable(cell) ? 1 : 0;
+        const SDL_FRect rect = GetRect(cell);
+        queue.AddSprite(layer, textures[kind], rect, uvs[kind]);
+        queue.AddOutline(debugLayer, rect, red);
+    }
+}
+
+/**
+ * @brief Queues one brick's sprite and collision outline, if it is unbroken.
+ *
+ * @param queue The render queue.
+ * @param cell The brick's cell.
+ * @param layer The layer for the sprite.
+ * @param debugLayer The layer for the collision outline.
+ */
+void BrickField::RenderCell(RenderQueue &queue, uint32_t cell, uint8_t layer, uint8_t debugLayer) const
+{
+    if (!IsAlive(cell))
+        return;
+    const ResourceManager &resources = ResourceManager::getInstance();
+    const TextureHandle texture = IsUnbreakable(cell) ? mUnbrickTexture : mBrickTexture;
+    const SDL_FRect rect = GetRect(cell);
+    queue.AddSprite(layer, resources.GetTexture(texture), rect, resources.GetUV(texture));
+    queue.AddOutline(debugLayer, rect, SDL_Color{255, 0, 0, 255});
+}
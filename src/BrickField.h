@@ -0,0 +1,124 @@
+#ifndef BRICKFIELD_H
+#define BRICKFIELD_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <SDL2/SDL.h>
+#include "SceneFile.h"
+#include "RenderQueue.h"
+#include "ResourceManager.h"
+
+/**
+ * @brief The BrickField class holds a scene's bricks as a dense lattice of cells instead of entities.
+ *
+ * Scene files place bricks on a regular pitch, so a brick is fully described by its cell
+ * and a few bits of state, packed into one byte per cell: present, alive, unbreakable and
+ * the hits left before it breaks. Every brick shares the field's size and its two textures.
+ * Positions are computed from the cell, collision candidates come from the range of cells a
+ * rectangle covers, and a million bricks take about a megabyte.
+ *
+ * Build() works out the lattice from the records. Bricks that are off the lattice (or
+ * duplicate a cell, or differ in size) are handed back for the scene to keep as Brick
+ * entities.
+ *
+ * Cells are numbered row by row, left to right; queries and renders visit them in that order.
+ */
+class BrickField
+{
+public:
+    void Clear();
+    void Build(const SceneBrickRecord *records, size_t count, float brickW, float brickH, bool unbreakableFits,
+               std::vector<uint32_t> &offLattice);
+    bool Place(float x, float y, bool unbreakable, uint32_t &cell);
+    void Remove(uint32_t cell);
+    bool Hit(uint32_t cell);
+    void Query(const SDL_FRect &rect, std::vector<uint32_t> &out) const;
+    void Render(RenderQueue &queue, uint8_t layer, uint8_t debugLayer) const;
+    void RenderCell(RenderQueue &queue, uint32_t cell, uint8_t layer, uint8_t debugLayer) const;
+
+    /**
+     * @brief Sets the textures bricks are drawn with.
+     *
+     * @param brick The breakable bricks' texture.
+     * @param unbrick The unbreakable bricks' texture.
+     */
+    void SetTextures(TextureHandle brick, TextureHandle unbrick)
+    {
+        mBrickTexture = brick;
+        mUnbrickTexture = unbrick;
+    }
+
+    /**
+     * @brief Returns whether a cell holds a brick, broken or not.
+     */
+    bool IsPresent(uint32_t cell) const { return (mCells[cell] & kPresent) != 0; }
+
+    /**
+     * @brief Returns whether a cell holds a brick that has not been broken.
+     */
+    bool IsAlive(uint32_t cell) const { return (mCells[cell] & kAlive) != 0; }
+
+    /**
+     * @brief Returns whether a cell holds an unbreakable brick.
+     */
+    bool IsUnbreakable(uint32_t cell) const { return (mCells[cell] & kUnbreakable) != 0; }
+
+    /**
+     * @brief Returns the rectangle of a cell's brick.
+     */
+    SDL_FRect GetRect(uint32_t cell) const
+    {
+        return SDL_FRect{mColX[cell % mCols], mRowY[cell / mCols], mBrickW, mBrickH};
+    }
+
+    /**
+     * @brief Returns the number of cells, with or without a brick. Cell indices are below it.
+     */
+    size_t GetCellCount() const { return mCells.size(); }
+
+    /**
+     * @brief Returns the number of bricks in the field, broken or not.
+     */
+    size_t GetBrickCount() const { return mBrickCount; }
+
+    /**
+     * @brief Returns the number of breakable bricks not yet broken.
+     */
+    size_t GetAliveBreakable() const { return mAliveBreakable; }
+
+    /**
+     * @brief Returns the heap memory the field uses, in bytes.
+     */
+    size_t GetMemoryBytes() const
+    {
+        return mCells.capacity() + (mColX.capacity() + mRowY.capacity()) * sizeof(float);
+    }
+
+private:
+    static constexpr uint8_t kPresent = 1;
+    static constexpr uint8_t kAlive = 2;
+    static constexpr uint8_t kUnbreakable = 4;
+    static constexpr uint8_t kHitShift = 3;          // hits left, 0 to 3, in bits 3-4
+    static constexpr uint8_t kHitMask = 3 << kHitShift;
+
+    bool CellOf(float x, float y, uint32_t &cell) const;
+    void SetBrick(uint32_t cell, bool unbreakable);
+
+    std::vector<uint8_t> mCells;
+    std::vector<float> mColX; // left edge of every column
+    std::vector<float> mRowY; // top edge of every row
+    int mCols = 0;
+    int mRows = 0;
+    float mRefX = 0.0f, mRefY = 0.0f;     // a brick position the lattice goes through
+    float mPitchX = 0.0f, mPitchY = 0.0f;
+    int mColMin = 0, mRowMin = 0;         // lattice index of column 0 and row 0, relative to mRefX/mRefY
+    float mBrickW = 0.0f, mBrickH = 0.0f;
+    bool mUnbreakableFits = true;
+    size_t mBrickCount = 0;
+    size_t mAliveBreakable = 0;
+    TextureHandle mBrickTexture;
+    TextureHandle mUnbrickTexture;
+};
+
+#endif
@@ -0,0 +1,149 @@
+#include "BrickGrid.h"
+#include <algorithm>
+#include <cmath>
+
+/**
+ * @brief Constructs an empty BrickGrid.
+ *
+ * @param cellSize The side length of a grid cell, in pixels. Defaults to the 45px brick pitch used by the scene files.
+ */
+BrickGrid::BrickGrid(float cellSize)
+    : mCellSize(cellSize), mOriginX(0), mOriginY(0), mCols(0), mRows(0)
+{
+}
+
+/**
+ * @brief Rebuilds the grid from the scene's bricks.
+ *
+ * The grid covers the bounding box of all bricks. Inactive bricks are skipped, so a
+ * rebuilt grid only ever returns bricks that can still be hit.
+ *
+ * @param bricks The scene's brick vector; grid entries are indices into it.
+ */
+void BrickGrid::Build(const std::vector<std::shared_ptr<Brick>> &bricks)
+{
+    Clear();
+    mBrickRects.resize(bricks.size(), SDL_FRect{0, 0, 0, 0});
+    if (bricks.empty())
+        return;
+
+    float minX = INFINITY, minY = INFINITY, maxX = -INFINITY, maxY = -INFINITY;
+    for (size_t i = 0; i < bricks.size(); ++i)
+    {
+        auto trans = bricks[i]->GetTransform();
+        if (!trans)
+            continue;
+        SDL_FRect rect = trans->getRectangle();
+        mBrickRects[i] = rect;
+        minX = std::min(minX, rect.x);
+        minY = std::min(minY, rect.y);
+        maxX = std::max(maxX, rect.x + rect.w);
+        maxY = std::max(maxY, rect.y + rect.h);
+    }
+    if (minX > maxX)
+        return;
+
+    mOriginX = minX;
+    mOriginY = minY;
+    mCols = static_cast<int>((maxX - minX) / mCellSize) + 1;
+    mRows = static_cast<int>((maxY - minY) / mCellSize) + 1;
+    mCells.assign(static_cast<size_t>(mCols) * mRows, {});
+
+    for (size_t i = 0; i < bricks.size(); ++i)
+    {
+        if (!bricks[i]->IsActive())
+            continue;
+        int col0, row0, col1, row1;
+        if (!CellRange(mBrickRects[i], col0, row0, col1, row1))
+            continue;
+        for (int row = row0; row <= row1; ++row)
+            for (int col = col0; col <= col1; ++col)
+                mCells[static_cast<size_t>(row) * mCols + col].push_back(static_cast<uint32_t>(i));
+    }
+}
+
+/**
+ * @brief Removes a brick from every cell it occupies.
+ *
+ * Called when a brick is deactivated so later queries no longer return it.
+ *
+ * @param brickIndex The brick's index in the scene's brick vector.
+ */
+void BrickGrid::Remove(uint32_t brickIndex)
+{
+    if (brickIndex >= mBrickRects.size())
+        return;
+    int col0, row0, col1, row1;
+    if (!CellRange(mBrickRects[brickIndex], col0, row0, col1, row1))
+        return;
+    for (int row = row0; row <= row1; ++row)
+    {
+        for (int col = col0; col <= col1; ++col)
+        {
+            auto &cell = mCells[static_cast<size_t>(row) * mCols + col];
+            auto it = std::find(cell.begin(), cell.end(), brickIndex);
+            if (it != cell.end())
+            {
+                *it = cell.back();
+                cell.pop_back();
+            }
+        }
+    }
+}
+
+/**
+ * @brief Collects the bricks that share a cell with the given rectangle.
+ *
+ * @param rect The query rectangle (typically a ball's collision rectangle).
+ * @param out Receives the candidate brick indices, sorted ascending and without duplicates.
+ */
+void BrickGrid::Query(const SDL_FRect &rect, std::vector<uint32_t> &out) const
+{
+    out.clear();
+    int col0, row0, col1, row1;
+    if (!CellRange(rect, col0, row0, col1, row1))
+        return;
+    for (int row = row0; row <= row1; ++row)
+    {
+        for (int col = col0; col <= col1; ++col)
+        {
+            const auto &cell = mCells[static_cast<size_t>(row) * mCols + col];
+            out.insert(out.end(), cell.begin(), cell.end());
+        }
+    }
+    std::sort(out.begin(), out.end());
+    out.erase(std::unique(out.begin(), out.end()), out.end());
+}
+
+/**
+ * @brief Empties the grid.
+ */
+void BrickGrid::Clear()
+{
+    mCells.clear();
+    mBrickRects.clear();
+    mCols = 0;
+    mRows = 0;
+}
+
+/**
+ * @brief Computes the inclusive range of cells a rectangle overlaps, clamped to the grid.
+ *
+ * @return true if the rectangle overlaps at least one cell, false otherwise.
+ */
+bool BrickGrid::CellRange(const SDL_FRect &rect, int &col0, int &row0, int &col1, int &row1) const
+{
+    if (mCols == 0 || mRows == 0)
+        return false;
+    col0 = static_cast<int>(std::floor((rect.x - mOriginX) / mCellSize));
+    row0 = static_cast<int>(std::floor((rect.y - mOriginY) / mCellSize));
+    col1 = static_cast<int>(std::floor((rect.x + rect.w - mOriginX) / mCellSize));
+    row1 = static_cast<int>(std::floor((rect.y + rect.h - mOriginY) / mCellSize));
+    if (col1 < 0 || row1 < 0 || col0 >= mCols || row0 >= mRows)
+        return false;
+    col0 = std::max(col0, 0);
+    row0 = std::max(row0, 0);
+    col1 = std::min(col1, mCols - 1);
+    row1 = std::min(row1, mRows - 1);
+    return true;
+}
@@ -0,0 +1,40 @@
+#ifndef BRICKGRID_H
+#define BRICKGRID_H
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <SDL2/SDL.h>
+#include "Brick.h"
+
+/**
+ * @brief The BrickGrid class is a uniform-grid broadphase for ball-vs-brick collision.
+ *
+ * Bricks are static and axis-aligned, so each active brick is bucketed once into every
+ * cell its rectangle overlaps. A query returns the indices (into the scene's brick vector)
+ * of the bricks sharing a cell with the given rectangle, in ascending order, so callers can
+ * keep the "first brick in scene order wins" behaviour of a plain linear scan.
+ */
+class BrickGrid
+{
+public:
+    explicit BrickGrid(float cellSize = 45.0f);
+
+    void Build(const std::vector<std::shared_ptr<Brick>> &bricks);
+    void Remove(uint32_t brickIndex);
+    void Query(const SDL_FRect &rect, std::vector<uint32_t> &out) const;
+    void Clear();
+
+private:
+    bool CellRange(const SDL_FRect &rect, int &col0, int &row0, int &col1, int &row1) const;
+
+    float mCellSize;
+    float mOriginX;
+    float mOriginY;
+    int mCols;
+    int mRows;
+    std::vector<std::vector<uint32_t>> mCells;
+    std::vector<SDL_FRect> mBrickRects;
+};
+
+#endif
@@ -4,44 +4,29 @@
 #include <iostream>
 
 /**
- * @brief Default constructor.
+ * @brief Constructs a new Collision2DComponent viewing a row of an ArchetypeStorage.
  *
- * Initializes the collision rectangle to (0, 0, 0, 0).
+ * @param storage The storage holding the entity's collision rectangle.
+ * @param handle The entity's row handle in that storage.
  */
-Collision2DComponent::Collision2DComponent() : mRectangle{0, 0, 0, 0} {}
-
-/**
- * @brief Parameterized constructor.
- *
- * Initializes the collision rectangle with the given parameters.
- *
- * @param x The x-coordinate of the rectangle.
- * @param y The y-coordinate of the rectangle.
- * @param w The width of the rectangle.
- * @param h The height of the rectangle.
- */
-Collision2DComponent::Collision2DComponent(float x, float y, float w, float h)
-    : mRectangle{x, y, w, h} {}
+Collision2DComponent::Collision2DComponent(ArchetypeStorage *storage, StorageHandle handle)
+    : mStorage(storage), mHandle(handle) {}
 
 /**
  * @brief Updates the collision rectangle.
  *
- * Retrieves the game entity's TransformComponent and updates the collision rectangle
- * to match the transform's rectangle.
+ * Copies the transform rectangle of the entity's storage row into its collision rectangle.
+ * ArchetypeStorage::SyncCollision() does the same for every row at once.
  *
  * @param deltaTime The time elapsed since the last update in seconds.
  */
 void Collision2DComponent::Update(float deltaTime)
 {
-    auto entity = GetGameEntity();
-    if (entity)
-    {
-        auto transform = entity->GetComponent<TransformComponent>(ComponentType::TransformComponent);
-        if (transform)
-        {
-            mRectangle = transform->getRectangle();
-        }
-    }
+    size_t row = Row();
+    mStorage->mCollX[row] = mStorage->mX[row];
+    mStorage->mCollY[row] = mStorage->mY[row];
+    mStorage->mCollW[row] = mStorage->mW[row];
+    mStorage->mCollH[row] = mStorage->mH[row];
 }
 
 /**
@@ -53,6 +38,7 @@ void Collision2DComponent::Update(float deltaTime)
  */
 void Collision2DComponent::Render(SDL_Renderer *renderer)
 {
+    SDL_FRect rect = getRectangle();
     SDL_SetRenderDrawColor(renderer, 255, 0, 0, 255);
-    SDL_RenderDrawRectF(renderer, &mRectangle);
+    SDL_RenderDrawRectF(renderer, &rect);
 }
@@ -3,84 +3,101 @@
 
 #include "../include/Component.hpp"
 #include "../include/ComponentType.hpp"
+#include "ArchetypeStorage.h"
 #include <SDL2/SDL.h>
 #include <memory>
 
 /**
  * @brief The Collision2DComponent class provides a 2D collision detection rectangle for game entities.
  *
- * This component maintains a SDL_FRect that represents the collision boundary of the entity.
- * The rectangle is updated based on the entity's TransformComponent data.
+ * This component is a view onto the collision rectangle stored in the entity's ArchetypeStorage row.
+ * The rectangle is updated based on the entity's transform data.
  */
 class Collision2DComponent : public Component
 {
 public:
-    Collision2DComponent();
-    Collision2DComponent(float x, float y, float w, float h);
+    /**
+     * @brief The slot this component occupies in a GameEntity, known at compile time.
+     */
+    static constexpr ComponentType StaticType = ComponentType::Collision2DComponent;
+
+    Collision2DComponent(ArchetypeStorage *storage, StorageHandle handle);
     virtual ~Collision2DComponent() = default;
 
+    /**
+     * @brief Points the component at another storage row, for an entity reused from an EntityPool.
+     *
+     * @param storage The storage holding the entity's data.
+     * @param handle The entity's new row handle in that storage.
+     */
+    void Bind(ArchetypeStorage *storage, StorageHandle handle)
+    {
+        mStorage = storage;
+        mHandle = handle;
+    }
+
     /**
      * @brief Sets the x-coordinate of the collision rectangle.
      *
      * @param x The new x-coordinate.
      */
-    void setX(float x) { mRectangle.x = x; }
+    void setX(float x) { mStorage->mCollX[Row()] = x; }
 
     /**
      * @brief Sets the y-coordinate of the collision rectangle.
      *
      * @param y The new y-coordinate.
      */
-    void setY(float y) { mRectangle.y = y; }
+    void setY(float y) { mStorage->mCollY[Row()] = y; }
 
     /**
      * @brief Gets the x-coordinate of the collision rectangle.
      *
      * @return float The current x-coordinate.
      */
-    float getX() const { return mRectangle.x; }
+    float getX() const { return mStorage->mCollX[Row()]; }
 
     /**
      * @brief Gets the y-coordinate of the collision rectangle.
      *
      * @return float The current y-coordinate.
      */
-    float getY() const { return mRectangle.y; }
+    float getY() const { return mStorage->mCollY[Row()]; }
 
     /**
      * @brief Sets the width of the collision rectangle.
      *
      * @param w The new width.
      */
-    void setW(float w) { mRectangle.w = w; }
+    void setW(float w) { mStorage->mCollW[Row()] = w; }
 
     /**
      * @brief Sets the height of the collision rectangle.
      *
      * @param h The new height.
      */
-    void setH(float h) { mRectangle.h = h; }
+    void setH(float h) { mStorage->mCollH[Row()] = h; }
 
     /**
      * @brief Gets the width of the collision rectangle.
      *
      * @return float The current width.
      */
-    float getW() const { return mRectangle.w; }
+    float getW() const { return mStorage->mCollW[Row()]; }
 
     /**
      * @brief Gets the height of the collision rectangle.
      *
      * @return float The current height.
      */
-    float getH() const { return mRectangle.h; }
+    float getH() const { return mStorage->mCollH[Row()]; }
 
     /**
      * @brief Retrieves the current collision rectangle.
      *
      * @return SDL_FRect The collision rectangle.
      */
-    SDL_FRect getRectangle() const { return mRectangle; }
+    SDL_FRect getRectangle() const { return mStorage->GetCollisionRect(Row()); }
 
     virtual void Update(float deltaTime) override;
     virtual void Render(SDL_Renderer *renderer) override;
@@ -90,25 +107,33 @@ public:
      *
      * @return ComponentType The type of this component.
      */
-    virtual ComponentType GetType() const override { return ComponentType::Collision2DComponent; }
+    virtual ComponentType GetType() const override { return StaticType; }
 
     /**
      * @brief Sets the game entity that owns this component.
      *
-     * @param entity Shared pointer to the game entity.
+     * The reference is non-owning; the entity owns this component.
+     *
+     * @param entity Pointer to the game entity.
      */
-    virtual void SetGameEntity(std::shared_ptr<GameEntity> entity) override { mGameEntity = entity; }
+    virtual void SetGameEntity(GameEntity *entity) override { mGameEntity = entity; }
 
     /**
      * @brief Gets the game entity that owns this component.
      *
-     * @return std::shared_ptr<GameEntity> The owning game entity.
+     * @return GameEntity* The owning game entity.
      */
-    virtual std::shared_ptr<GameEntity> GetGameEntity() const override { return mGameEntity; }
+    virtual GameEntity *GetGameEntity() const override { return mGameEntity; }
 
 private:
-    SDL_FRect mRectangle;
-    std::shared_ptr<GameEntity> mGameEntity;
+    /**
+     * @brief Returns the current dense row of the viewed entity.
+     */
+    size_t Row() const { return mStorage->Dense(mHandle); }
+
+    ArchetypeStorage *mStorage;
+    StorageHandle mHandle;
+    GameEntity *mGameEntity = nullptr;
 };
 
 #endif
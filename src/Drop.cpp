@@ -18,6 +18,20 @@ Drop::Drop(SDL_Renderer *renderer, const char *texturePath, float speed)
 {
 }
 
+/**
+ * @brief Initializes the drop's components and stores its falling speed as the row's velocity.
+ *
+ * This lets the scene move all drops with one ArchetypeStorage::Integrate() sweep.
+ *
+ * @param texture The drop texture.
+ * @param storage The scene's drop storage.
+ */
+void Drop::initComponents(TextureHandle texture, ArchetypeStorage *storage)
+{
+    GameEntity::initComponents(texture, storage);
+    mStorage->mVelY[StorageRow()] = mSpeed;
+}
+
 /**
  * @brief Updates the drop's state.
  *
@@ -28,7 +42,7 @@ Drop::Drop(SDL_Renderer *renderer, const char *texturePath, float speed)
  */
 void Drop::Update(float deltaTime)
 {
-    auto trans = GetComponent<TransformComponent>(ComponentType::TransformComponent);
+    auto trans = GetComponent<TransformComponent>();
     if (!trans)
         return;
     float x = trans->getX();
@@ -36,7 +50,7 @@ void Drop::Update(float deltaTime)
     y += mSpeed * deltaTime;
     trans->move(x, y);
 
-    auto coll = GetComponent<Collision2DComponent>(ComponentType::Collision2DComponent);
+    auto coll = GetComponent<Collision2DComponent>();
     if (coll)
         coll->Update(deltaTime);
 }
@@ -14,6 +14,7 @@ class Drop : public GameEntity
 {
 public:
     Drop(SDL_Renderer *renderer, const char *texturePath, float speed);
+    virtual void initComponents(TextureHandle texture, ArchetypeStorage *storage) override;
     virtual void Update(float deltaTime) override;
 };
 
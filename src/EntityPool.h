@@ -0,0 +1,88 @@
+#ifndef ENTITYPOOL_H
+#define ENTITYPOOL_H
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief The EntityPool class recycles short-lived entities (balls, drops) of one type.
+ *
+ * Released entities keep their memory and their components; Acquire() hands one back
+ * instead of constructing a new one, and GameEntity::initComponents() then rebinds the
+ * existing components to a fresh storage row. Once the pool has grown to a scene's peak
+ * population, spawning and killing entities allocates nothing.
+ *
+ * @tparam T The entity type, derived from GameEntity.
+ */
+template <typename T>
+class EntityPool
+{
+public:
+    /**
+     * @brief Returns a released entity, or constructs one if none is free.
+     *
+     * A recycled entity has no storage row and no handle; call initComponents() on it as
+     * on a new one.
+     *
+     * @param args The constructor arguments, used only when a new entity is needed.
+     * @return std::shared_ptr<T> The entity.
+     */
+    template <typename... Args>
+    std::shared_ptr<T> Acquire(Args &&...args)
+    {
+        if (mFree.empty())
+        {
+            ++mCreated;
+            return std::make_shared<T>(std::forward<Args>(args)...);
+        }
+        std::shared_ptr<T> entity = std::move(mFree.back());
+        mFree.pop_back();
+        return entity;
+    }
+
+    /**
+     * @brief Takes back an entity that left the scene, freeing its storage row.
+     *
+     * @param entity The entity; the pool must be its only owner from now on.
+     */
+    void Release(std::shared_ptr<T> entity)
+    {
+        entity->ReleaseStorage();
+        mFree.push_back(std::move(entity));
+    }
+
+    /**
+     * @brief Constructs entities up front so the pool can serve count acquisitions without allocating.
+     *
+     * @param count The number of free entities wanted.
+     * @param args The constructor arguments.
+     */
+    template <typename... Args>
+    void Reserve(size_t count, const Args &...args)
+    {
+        mFree.reserve(count);
+        while (mFree.size() < count)
+        {
+            ++mCreated;
+            mFree.push_back(std::make_shared<T>(args...));
+        }
+    }
+
+    /**
+     * @brief Returns the number of entities ready to be reused.
+     */
+    size_t GetFreeCount() const { return mFree.size(); }
+
+    /**
+     * @brief Returns the number of entities the pool has ever constructed.
+     */
+    size_t GetCreatedCount() const { return mCreated; }
+
+private:
+    std::vector<std::shared_ptr<T>> mFree;
+    size_t mCreated = 0;
+};
+
+#endif
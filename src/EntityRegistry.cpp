@@ -0,0 +1,72 @@
+#include "EntityRegistry.h"
+
+/**
+ * @brief Registers an entity and returns its handle.
+ *
+ * @param entity The entity to register (non-owning).
+ * @return EntityHandle The new handle.
+ */
+EntityHandle EntityRegistry::Create(GameEntity *entity)
+{
+    uint32_t index;
+    if (!mFreeSlots.empty())
+    {
+        index = mFreeSlots.back();
+        mFreeSlots.pop_back();
+    }
+    else
+    {
+        index = static_cast<uint32_t>(mSlots.size());
+        mSlots.push_back(Slot{nullptr, 0});
+    }
+    mSlots[index].entity = entity;
+    ++mLive;
+    return EntityHandle{index, mSlots[index].generation};
+}
+
+/**
+ * @brief Unregisters an entity, invalidating every copy of its handle.
+ *
+ * Destroying a stale handle does nothing.
+ *
+ * @param handle The handle to destroy.
+ */
+void EntityRegistry::Destroy(EntityHandle handle)
+{
+    if (!Get(handle))
+        return;
+    mSlots[handle.index].entity = nullptr;
+    mSlots[handle.index].generation++;
+    mFreeSlots.push_back(handle.index);
+    --mLive;
+}
+
+/**
+ * @brief Resolves a handle.
+ *
+ * @param handle The handle to resolve.
+ * @return GameEntity* The entity, or nullptr if the handle is stale or invalid.
+ */
+GameEntity *EntityRegistry::Get(EntityHandle handle) const
+{
+    if (handle.index >= mSlots.size() || mSlots[handle.index].generation != handle.generation)
+        return nullptr;
+    return mSlots[handle.index].entity;
+}
+
+/**
+ * @brief Unregisters every entity.
+ */
+void EntityRegistry::Clear()
+{
+    for (uint32_t index = 0; index < mSlots.size(); ++index)
+    {
+        if (mSlots[index].entity)
+        {
+            mSlots[index].entity = nullptr;
+            mSlots[index].generation++;
+            mFreeSlots.push_back(index);
+        }
+    }
+    mLive = 0;
+}
@@ -0,0 +1,65 @@
+#ifndef ENTITYREGISTRY_H
+#define ENTITYREGISTRY_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+
+class GameEntity;
+
+/**
+ * @brief A weak reference to a GameEntity: a slot index plus the slot's generation.
+ *
+ * A handle never keeps its entity alive. Once the entity is destroyed its slot's generation
+ * moves on, so resolving an old handle yields nullptr instead of a dangling pointer.
+ */
+struct EntityHandle
+{
+    uint32_t index = UINT32_MAX;
+    uint32_t generation = 0;
+
+    bool operator==(const EntityHandle &other) const { return index == other.index && generation == other.generation; }
+    bool operator!=(const EntityHandle &other) const { return !(*this == other); }
+};
+
+/**
+ * @brief The EntityRegistry class hands out generational handles for the entities of a scene.
+ *
+ * The registry does not own entities; the scene does. Freed slots are recycled with a bumped
+ * generation, so handle storage stays bounded however many entities are spawned and killed.
+ */
+class EntityRegistry
+{
+public:
+    EntityHandle Create(GameEntity *entity);
+    void Destroy(EntityHandle handle);
+    GameEntity *Get(EntityHandle handle) const;
+    void Clear();
+
+    /**
+     * @brief Reserves room for a number of entities, so bulk loads do not regrow the slot array.
+     *
+     * @param count The total number of entities to make room for.
+     */
+    void Reserve(size_t count) { mSlots.reserve(count); }
+
+    /**
+     * @brief Returns the number of live entities.
+     *
+     * @return size_t The number of registered entities that have not been destroyed.
+     */
+    size_t Size() const { return mLive; }
+
+private:
+    struct Slot
+    {
+        GameEntity *entity;
+        uint32_t generation;
+    };
+
+    std::vector<Slot> mSlots;
+    std::vector<uint32_t> mFreeSlots;
+    size_t mLive = 0;
+};
+
+#endif
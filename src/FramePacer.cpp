@@ -0,0 +1,64 @@
+#include "FramePacer.h"
+#include <algorithm>
+
+/**
+ * @brief Constructs a new FramePacer object.
+ *
+ * @param periodSeconds The target frame period in seconds (e.g. 1/60).
+ */
+FramePacer::FramePacer(double periodSeconds)
+    : mPeriod(static_cast<Uint64>(periodSeconds * static_cast<double>(SDL_GetPerformanceFrequency()))),
+      mDeadline(0),
+      mSleepMargin(SDL_GetPerformanceFrequency() / 500), // 2ms until measured
+      mLastError(0.0)
+{
+    Reset();
+}
+
+/**
+ * @brief Starts a new period from now, e.g. after a pause or a long load.
+ */
+void FramePacer::Reset()
+{
+    mDeadline = SDL_GetPerformanceCounter() + mPeriod;
+}
+
+/**
+ * @brief Blocks until the end of the current period, then starts the next one.
+ *
+ * If the frame already overran its deadline by more than a period, the schedule is
+ * restarted from now instead of trying to catch up with a burst of short frames.
+ */
+void FramePacer::Wait()
+{
+    const Uint64 frequency = SDL_GetPerformanceFrequency();
+    const Uint64 ticksPerMs = std::max<Uint64>(frequency / 1000, 1);
+    const Uint64 minMargin = frequency / 2000; // never spin for less than 0.5ms
+
+    Uint64 now = SDL_GetPerformanceCounter();
+    while (now + mSleepMargin < mDeadline)
+    {
+        const Uint32 sleepMs = static_cast<Uint32>((mDeadline - now - mSleepMargin) / ticksPerMs);
+        if (sleepMs == 0)
+            break;
+        SDL_Delay(sleepMs);
+        const Uint64 woke = SDL_GetPerformanceCounter();
+        const Uint64 requested = sleepMs * ticksPerMs;
+        const Uint64 overslept = woke - now > requested ? woke - now - requested : 0;
+        // Grow at once on a bad oversleep, shrink very slowly when sleeps are accurate.
+        if (overslept + minMargin > mSleepMargin)
+            mSleepMargin = overslept + minMargin;
+        else
+            mSleepMargin = std::max(minMargin, mSleepMargin - (mSleepMargin - overslept - minMargin) / 256);
+        now = woke;
+    }
+
+    while (now < mDeadline)
+        now = SDL_GetPerformanceCounter();
+
+    mLastError = static_cast<double>(now - mDeadline) / static_cast<double>(frequency);
+    if (now - mDeadline > mPeriod)
+        mDeadline = now + mPeriod;
+    else
+        mDeadline += mPeriod;
+}
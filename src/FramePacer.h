@@ -0,0 +1,36 @@
+#ifndef FRAMEPACER_H
+#define FRAMEPACER_H
+
+#include <SDL2/SDL.h>
+
+/**
+ * @brief The FramePacer class holds a loop to a fixed period using a sleep-then-spin wait.
+ *
+ * SDL_Delay() only guarantees a lower bound and typically oversleeps by a millisecond or
+ * more, so Wait() sleeps until a safety margin before the deadline and busy-waits on the
+ * high-resolution counter for the rest. The margin adapts to the oversleep actually observed.
+ * Deadlines advance by whole periods, so small errors do not accumulate into drift.
+ */
+class FramePacer
+{
+public:
+    explicit FramePacer(double periodSeconds);
+
+    void Wait();
+    void Reset();
+
+    /**
+     * @brief Returns how late the last Wait() returned relative to its deadline.
+     *
+     * @return double The error in seconds (0 or positive; late frames report their lateness).
+     */
+    double GetLastError() const { return mLastError; }
+
+private:
+    Uint64 mPeriod;
+    Uint64 mDeadline;
+    Uint64 mSleepMargin;
+    double mLastError;
+};
+
+#endif
@@ -17,6 +17,66 @@ GameEntity::GameEntity(SDL_Renderer *renderer, const char *texturePath, float sp
 {
 }
 
+/**
+ * @brief Destroys the GameEntity object, releasing its storage row.
+ */
+GameEntity::~GameEntity()
+{
+    ReleaseStorage();
+}
+
+/**
+ * @brief Initializes basic components for the game entity.
+ *
+ * Creates and adds a TextureComponent for the cached texture, then allocates a row in the given
+ * storage sized to the texture and adds a TransformComponent and a Collision2DComponent viewing
+ * that row. Components the entity already has are reused. Derived classes override this to seed
+ * their own per-row data (e.g. velocity) after calling the base.
+ *
+ * @param texture The entity's texture, loaded through ResourceManager.
+ * @param storage The storage for this kind of entity; it must outlive the entity.
+ */
+void GameEntity::initComponents(TextureHandle texture, ArchetypeStorage *storage)
+{
+    // An entity reused from an EntityPool already has these components: rebind them
+    // instead of allocating new ones.
+    TextureComponent *texComp = GetComponent<TextureComponent>();
+    if (texComp)
+        texComp->SetTexture(texture);
+    else
+    {
+        AddComponent<TextureComponent>(std::make_shared<TextureComponent>(texture));
+        texComp = GetComponent<TextureComponent>();
+    }
+
+    ReleaseStorage();
+    SDL_FRect texRect = texComp->getRectangle();
+    mStorage = storage;
+    mStorageHandle = mStorage->Allocate(this, 0, 0, texRect.w, texRect.h);
+    mStorage->mTextures[StorageRow()] = texture;
+
+    if (TransformComponent *transform = GetComponent<TransformComponent>())
+        transform->Bind(mStorage, mStorageHandle);
+    else
+        AddComponent<TransformComponent>(std::make_shared<TransformComponent>(mStorage, mStorageHandle));
+    if (Collision2DComponent *collision = GetComponent<Collision2DComponent>())
+        collision->Bind(mStorage, mStorageHandle);
+    else
+        AddComponent<Collision2DComponent>(std::make_shared<Collision2DComponent>(mStorage, mStorageHandle));
+}
+
+/**
+ * @brief Gives the entity's row back to its storage.
+ *
+ * Safe to call more than once, and after the storage was cleared.
+ */
+void GameEntity::ReleaseStorage()
+{
+    if (mStorage)
+        mStorage->Release(mStorageHandle);
+    mStorageHandle = StorageHandle{};
+}
+
 /**
  * @brief Tests collision between this entity and another.
  *
@@ -27,8 +87,8 @@ GameEntity::GameEntity(SDL_Renderer *renderer, const char *texturePath, float sp
  */
 bool GameEntity::TestCollision(std::shared_ptr<GameEntity> otherRect)
 {
-    auto collThis = GetComponent<Collision2DComponent>(ComponentType::Collision2DComponent);
-    auto collOther = otherRect->GetComponent<Collision2DComponent>(ComponentType::Collision2DComponent);
+    auto collThis = GetComponent<Collision2DComponent>();
+    auto collOther = otherRect->GetComponent<Collision2DComponent>();
     if (!collThis || !collOther)
         return false;
 
@@ -52,14 +112,14 @@ bool GameEntity::TestCollision(std::shared_ptr<GameEntity> otherRect)
  */
 void GameEntity::Update(float deltaTime)
 {
-    auto tex = GetComponent<TransformComponent>(ComponentType::TransformComponent);
+    auto tex = GetComponent<TransformComponent>();
     if (tex)
     {
         float newX = tex->getX() + xPositiveDirection * mSpeed * deltaTime;
         tex->move(newX, tex->getY());
     }
 
-    auto coll = GetComponent<Collision2DComponent>(ComponentType::Collision2DComponent);
+    auto coll = GetComponent<Collision2DComponent>();
     if (coll)
     {
         coll->Update(deltaTime);
@@ -76,14 +136,15 @@ void GameEntity::Update(float deltaTime)
  */
 void GameEntity::Render(SDL_Renderer *renderer)
 {
-    auto textureComp = GetComponent<TextureComponent>(ComponentType::TextureComponent);
-    auto transformComp = GetComponent<TransformComponent>(ComponentType::TransformComponent);
+    auto textureComp = GetComponent<TextureComponent>();
+    auto transformComp = GetComponent<TransformComponent>();
     if (textureComp && transformComp && renderable)
     {
         SDL_FRect rect = transformComp->getRectangle();
-        SDL_RenderCopyF(renderer, textureComp->getTexture(), nullptr, &rect);
+        SDL_Rect source = textureComp->getSourceRect();
+        SDL_RenderCopyF(renderer, textureComp->getTexture(), &source, &rect);
 
-        auto coll = GetComponent<Collision2DComponent>(ComponentType::Collision2DComponent);
+        auto coll = GetComponent<Collision2DComponent>();
         if (coll)
         {
             coll->Render(renderer);
@@ -100,7 +161,7 @@ void GameEntity::Render(SDL_Renderer *renderer)
  */
 float GameEntity::getX() const
 {
-    auto tex = const_cast<GameEntity *>(this)->GetComponent<TransformComponent>(ComponentType::TransformComponent);
+    auto tex = GetComponent<TransformComponent>();
     return tex ? tex->getX() : 0;
 }
 
@@ -113,6 +174,6 @@ float GameEntity::getX() const
  */
 float GameEntity::getY() const
 {
-    auto tex = const_cast<GameEntity *>(this)->GetComponent<TransformComponent>(ComponentType::TransformComponent);
+    auto tex = GetComponent<TransformComponent>();
     return tex ? tex->getY() : 0;
 }
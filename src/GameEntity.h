@@ -4,26 +4,31 @@
 #include "TextureComponent.h"
 #include "TransformComponent.h"
 #include "Collision2DComponent.h"
+#include "ArchetypeStorage.h"
+#include "EntityRegistry.h"
 #include "../include/Component.hpp"
 #include "../include/ComponentType.hpp"
-#include <map>
+#include <array>
 #include <memory>
+#include <type_traits>
 #include <SDL2/SDL.h>
 
 /**
  * @brief The GameEntity class serves as the base class for all game objects.
  *
  * It implements a component-based system where components such as texture,
- * transform and collision are stored in a map. Derived classes can add or override
- * functionality by adding or replacing components.
+ * transform and collision are stored in fixed slots indexed by ComponentType.
+ * Derived classes can add or override functionality by adding or replacing components.
+ * Components refer back to their entity with a plain non-owning pointer, so releasing the
+ * last owner of an entity frees it together with its components.
  */
-class GameEntity : public std::enable_shared_from_this<GameEntity>
+class GameEntity
 {
 public:
-    std::map<ComponentType, std::shared_ptr<Component>> mComponents;
+    std::array<std::shared_ptr<Component>, static_cast<size_t>(ComponentType::Count)> mComponents;
 
     GameEntity(SDL_Renderer *renderer, const char *texturePath, float speed);
-    virtual ~GameEntity() = default;
+    virtual ~GameEntity();
 
     /**
      * @brief Sets the horizontal movement direction for the entity.
@@ -42,21 +47,24 @@ public:
     bool TestCollision(std::shared_ptr<GameEntity> other);
 
     /**
-     * @brief Returns a shared pointer to this GameEntity.
+     * @brief Returns the handle the scene registered this entity under.
      *
-     * Useful for adding components to this entity.
+     * @return EntityHandle The entity's handle, or an invalid handle if it was never registered.
+     */
+    EntityHandle GetHandle() const { return mHandle; }
+
+    /**
+     * @brief Records the handle the scene registered this entity under.
      *
-     * @return std::shared_ptr<GameEntity> The shared pointer to this object.
+     * @param handle The handle returned by EntityRegistry::Create().
      */
-    std::shared_ptr<GameEntity> GetThisPtr()
-    {
-        return shared_from_this();
-    }
+    void SetHandle(EntityHandle handle) { mHandle = handle; }
 
     /**
      * @brief Adds a component to the entity.
      *
-     * The component's ownership is associated with this entity.
+     * The component's ownership is associated with this entity. It is stored in the
+     * slot for T::StaticType, replacing any component already there.
      *
      * @tparam T The type of the component.
      * @param comp A shared pointer to the component.
@@ -64,70 +72,65 @@ public:
     template <typename T>
     void AddComponent(std::shared_ptr<T> comp)
     {
-        comp->SetGameEntity(GetThisPtr());
-        mComponents[comp->GetType()] = comp;
+        static_assert(std::is_base_of<Component, T>::value, "T must derive from Component");
+        comp->SetGameEntity(this);
+        mComponents[static_cast<size_t>(T::StaticType)] = std::move(comp);
     }
 
     /**
      * @brief Retrieves a component by its type.
      *
-     * @tparam T The expected type of the component.
-     * @param type The component type identifier.
-     * @return std::shared_ptr<T> The shared pointer to the requested component, or nullptr if not found.
+     * The slot is resolved at compile time from T::StaticType, so the lookup is an array
+     * index plus a static_cast: no RTTI and no reference-count traffic. The returned
+     * pointer stays valid for as long as the entity keeps the component.
+     *
+     * @tparam T The type of the component.
+     * @return T* The requested component, or nullptr if the entity has none.
      */
     template <typename T>
-    std::shared_ptr<T> GetComponent(ComponentType type)
+    T *GetComponent() const
     {
-        auto it = mComponents.find(type);
-        if (it != mComponents.end())
-        {
-            return std::dynamic_pointer_cast<T>(it->second);
-        }
-        return nullptr;
+        static_assert(std::is_base_of<Component, T>::value, "T must derive from Component");
+        return static_cast<T *>(mComponents[static_cast<size_t>(T::StaticType)].get());
     }
 
+    virtual void initComponents(TextureHandle texture, ArchetypeStorage *storage);
+    void ReleaseStorage();
+
     /**
-     * @brief Initializes basic components for the game entity.
-     *
-     * Creates and adds a TextureComponent, a TransformComponent, and a Collision2DComponent
-     * using the given texture path. The initial transform and collision dimensions are based on the texture size.
+     * @brief Returns the entity's TransformComponent.
      *
-     * @param renderer The SDL_Renderer used for creating components.
-     * @param texturePath The path to the texture file.
+     * @return TransformComponent* The transform component, or nullptr if absent.
      */
-    void initComponents(SDL_Renderer *renderer, const char *texturePath)
+    TransformComponent *GetTransform() const
     {
-        std::shared_ptr<TextureComponent> texComp = std::make_shared<TextureComponent>(renderer, texturePath);
-        AddComponent<TextureComponent>(texComp);
-
-        std::shared_ptr<TransformComponent> transComp = std::make_shared<TransformComponent>(0, 0, texComp->getRectangle().w, texComp->getRectangle().h);
-        AddComponent<TransformComponent>(transComp);
-
-        std::shared_ptr<Collision2DComponent> collComp = std::make_shared<Collision2DComponent>(0, 0, texComp->getRectangle().w, texComp->getRectangle().h);
-        AddComponent<Collision2DComponent>(collComp);
+        return GetComponent<TransformComponent>();
     }
 
     /**
-     * @brief Returns the entity's TransformComponent.
+     * @brief Returns the entity's Collision2DComponent.
      *
-     * @return std::shared_ptr<TransformComponent> The transform component.
+     * @return Collision2DComponent* The collision component, or nullptr if absent.
      */
-    std::shared_ptr<TransformComponent> GetTransform()
+    Collision2DComponent *GetCollision2D() const
     {
-        return GetComponent<TransformComponent>(ComponentType::TransformComponent);
+        return GetComponent<Collision2DComponent>();
     }
 
     /**
-     * @brief Returns the entity's Collision2DComponent.
+     * @brief Returns the entity's current dense row in its ArchetypeStorage.
      *
-     * @return std::shared_ptr<Collision2DComponent> The collision component.
+     * Only valid after initComponents() and before ReleaseStorage().
+     *
+     * @return size_t The dense row index.
      */
-    std::shared_ptr<Collision2DComponent> GetCollision2D()
-    {
-        return GetComponent<Collision2DComponent>(ComponentType::Collision2DComponent);
-    }
+    size_t StorageRow() const { return mStorage->Dense(mStorageHandle); }
 
 protected:
+    ArchetypeStorage *mStorage = nullptr;
+    StorageHandle mStorageHandle;
+    EntityHandle mHandle;
+
     float mSpeed;
     int xPositiveDirection;
     bool renderable = true;
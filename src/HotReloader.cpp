@@ -0,0 +1,243 @@
+#include "HotReloader.h"
+#include <iostream>
+
+#ifdef __linux__
+#include <cerrno>
+#include <cstdint>
+#include <poll.h>
+#include <sys/eventfd.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Stops the watcher and frees the edits nobody took.
+ */
+HotReloader::~HotReloader()
+{
+    Stop();
+    for (ImageEdit &image : mImages)
+        SDL_FreeSurface(image.pixels);
+}
+
+/**
+ * @brief Starts watching files on a worker thread.
+ *
+ * The directories holding the files are watched, not the files themselves, so a file
+ * replaced by a rename is still followed.
+ *
+ * @param scenePaths Scene files, text or binary; a change is parsed into a SceneEdit.
+ * @param imagePaths BMP images; a change is decoded into an ImageEdit.
+ * @return bool False if no file could be watched or the platform has no inotify.
+ */
+bool HotReloader::Start(const std::vector<std::string> &scenePaths, const std::vector<std::string> &imagePaths)
+{
+#ifdef __linux__
+    Stop();
+    mNotifyFd = inotify_init1(IN_CLOEXEC);
+    mWakeFd = eventfd(0, EFD_CLOEXEC);
+    if (mNotifyFd < 0 || mWakeFd < 0)
+    {
+        std::cerr << "Hot reload unavailable: cannot create inotify instance" << std::endl;
+        Stop();
+        return false;
+    }
+
+    for (int kind = 0; kind < 2; ++kind)
+    {
+        for (const std::string &path : kind == 0 ? scenePaths : imagePaths)
+        {
+            const size_t slash = path.find_last_of('/');
+            Watch watch;
+            watch.directory = slash == std::string::npos ? "." : path.substr(0, slash);
+            watch.name = slash == std::string::npos ? path : path.substr(slash + 1);
+            watch.path = path;
+            watch.scene = kind == 0;
+            watch.descriptor = inotify_add_watch(mNotifyFd, watch.directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+            if (watch.descriptor < 0)
+            {
+                std::cerr << "Hot reload cannot watch " << watch.directory << std::endl;
+                continue;
+            }
+            mWatches.push_back(watch);
+        }
+    }
+    if (mWatches.empty())
+    {
+        Stop();
+        return false;
+    }
+
+    mWorker = std::thread(&HotReloader::WorkerLoop, this);
+    std::cout << "Hot reload watching " << mWatches.size() << " file(s)" << std::endl;
+    return true;
+#else
+    (void)scenePaths;
+    (void)imagePaths;
+    std::cerr << "Hot reload needs inotify, which this platform does not have" << std::endl;
+    return false;
+#endif
+}
+
+/**
+ * @brief Stops the worker thread and closes the watches. Edits already queued stay takeable.
+ */
+void HotReloader::Stop()
+{
+#ifdef __linux__
+    if (mWorker.joinable())
+    {
+        const uint64_t one = 1;
+        if (write(mWakeFd, &one, sizeof(one)) != static_cast<ssize_t>(sizeof(one)))
+            std::cerr << "Hot reload: cannot wake the watcher thread" << std::endl;
+        mWorker.join();
+    }
+    if (mNotifyFd >= 0)
+        close(mNotifyFd);
+    if (mWakeFd >= 0)
+        close(mWakeFd);
+#endif
+    mNotifyFd = -1;
+    mWakeFd = -1;
+    mWatches.clear();
+}
+
+/**
+ * @brief Hands over the edits queued since the last call, leaving the queue empty.
+ *
+ * Only the latest version of each file is kept, so a file saved twice between two calls
+ * yields one edit. The caller owns the taken images' surfaces.
+ *
+ * @param scenes Receives the parsed scene files, appended.
+ * @param images Receives the decoded images, appended.
+ */
+void HotReloader::Take(std::vector<SceneEdit> &scenes, std::vector<ImageEdit> &images)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    for (SceneEdit &scene : mScenes)
+        scenes.push_back(std::move(scene));
+    images.insert(images.end(), mImages.begin(), mImages.end());
+    mScenes.clear();
+    mImages.clear();
+    mPending.store(false, std::memory_order_release);
+}
+
+/**
+ * @brief The worker thread: waits for inotify events and reloads the watched files they name.
+ *
+ * Saving a file often raises several events in quick succession, so changed files are only
+ * reloaded once no event arrived for kSettleMs.
+ */
+void HotReloader::WorkerLoop()
+{
+#ifdef __linux__
+    const int kSettleMs = 50;
+    alignas(inotify_event) char buffer[4096];
+    std::vector<bool> changed(mWatches.size(), false);
+    bool anyChanged = false;
+
+    while (true)
+    {
+        pollfd fds[2] = {{mNotifyFd, POLLIN, 0}, {mWakeFd, POLLIN, 0}};
+        const int ready = poll(fds, 2, anyChanged ? kSettleMs : -1);
+        if (ready < 0)
+        {
+            if (errno == EINTR)
+                continue;
+            std::cerr << "Hot reload stopped: poll failed" << std::endl;
+            return;
+        }
+        if (fds[1].revents)
+            return;
+        if (ready == 0)
+        {
+            for (size_t i = 0; i < mWatches.size(); ++i)
+            {
+                if (changed[i])
+                    Reload(mWatches[i]);
+            }
+            changed.assign(mWatches.size(), false);
+            anyChanged = false;
+            continue;
+        }
+
+        const ssize_t length = read(mNotifyFd, buffer, sizeof(buffer));
+        if (length <= 0)
+            continue;
+        for (ssize_t offset = 0; offset < length;)
+        {
+            const inotify_event *event = reinterpret_cast<const inotify_event *>(buffer + offset);
+            offset += static_cast<ssize_t>(sizeof(inotify_event) + event->len);
+            // Events were dropped: reload everything rather than miss a change.
+            const bool overflow = (event->mask & IN_Q_OVERFLOW) != 0;
+            for (size_t i = 0; i < mWatches.size(); ++i)
+            {
+                if (overflow || (event->len > 0 && event->wd == mWatches[i].descriptor && mWatches[i].name == event->name))
+                {
+                    changed[i] = true;
+                    anyChanged = true;
+                }
+            }
+        }
+    }
+#endif
+}
+
+/**
+ * @brief Parses or decodes one changed file and queues it, replacing any older version still queued.
+ *
+ * A file that fails to load (e.g. a scene saved with a syntax error) is reported and skipped;
+ * the running game keeps what it has until the next save.
+ *
+ * @param watch The watched file.
+ */
+void HotReloader::Reload(const Watch &watch)
+{
+    if (watch.scene)
+    {
+        SceneEdit edit;
+        edit.path = watch.path;
+        if (!LoadSceneData(watch.path, edit.records))
+        {
+            std::cerr << "Hot reload skipped " << watch.path << std::endl;
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mMutex);
+        bool replaced = false;
+        for (SceneEdit &queued : mScenes)
+        {
+            if (queued.path == edit.path)
+            {
+                queued = std::move(edit);
+                replaced = true;
+                break;
+            }
+        }
+        if (!replaced)
+            mScenes.push_back(std::move(edit));
+    }
+    else
+    {
+        SDL_Surface *pixels = SDL_LoadBMP(watch.path.c_str());
+        if (!pixels)
+        {
+            SDL_Log("Hot reload skipped %s: %s", watch.path.c_str(), SDL_GetError());
+            return;
+        }
+        std::lock_guard<std::mutex> lock(mMutex);
+        bool replaced = false;
+        for (ImageEdit &queued : mImages)
+        {
+            if (queued.path == watch.path)
+            {
+                SDL_FreeSurface(queued.pixels);
+                queued.pixels = pixels;
+                replaced = true;
+                break;
+            }
+        }
+        if (!replaced)
+            mImages.push_back(ImageEdit{watch.path, pixels});
+    }
+    mPending.store(true, std::memory_order_release);
+}
@@ -0,0 +1,83 @@
+#ifndef HOTRELOADER_H
+#define HOTRELOADER_H
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <SDL2/SDL.h>
+#include "SceneFile.h"
+
+/**
+ * @brief A scene file that changed on disk, already parsed.
+ */
+struct SceneEdit
+{
+    std::string path; // as passed to HotReloader::Start()
+    SceneData records;
+};
+
+/**
+ * @brief An image that changed on disk, already decoded.
+ */
+struct ImageEdit
+{
+    std::string path;     // as passed to HotReloader::Start()
+    SDL_Surface *pixels;  // owned by whoever takes the edit
+};
+
+/**
+ * @brief The HotReloader class watches scene files and images and reloads them as they are saved.
+ *
+ * A worker thread blocks on inotify for the directories of the watched files. When one of
+ * the files is written (or renamed over, as many editors save), the worker waits for the
+ * burst of events to settle, then parses the scene or decodes the BMP itself and queues the
+ * result. The render thread polls HasChanges(), a single atomic load, and only takes the
+ * queued edits when there are some, so watching costs nothing per frame while nothing changes.
+ *
+ * inotify is Linux only; elsewhere Start() reports that hot reload is unavailable.
+ */
+class HotReloader
+{
+public:
+    HotReloader() = default;
+    ~HotReloader();
+    HotReloader(const HotReloader &) = delete;
+    HotReloader &operator=(const HotReloader &) = delete;
+
+    bool Start(const std::vector<std::string> &scenePaths, const std::vector<std::string> &imagePaths);
+    void Stop();
+
+    /**
+     * @brief Returns whether edits are waiting to be taken.
+     */
+    bool HasChanges() const { return mPending.load(std::memory_order_acquire); }
+
+    void Take(std::vector<SceneEdit> &scenes, std::vector<ImageEdit> &images);
+
+private:
+    struct Watch
+    {
+        std::string directory;
+        std::string name;
+        std::string path;
+        bool scene;
+        int descriptor;
+    };
+
+    void WorkerLoop();
+    void Reload(const Watch &watch);
+
+    std::vector<Watch> mWatches;
+    int mNotifyFd = -1;
+    int mWakeFd = -1;
+    std::thread mWorker;
+
+    std::mutex mMutex;
+    std::vector<SceneEdit> mScenes;
+    std::vector<ImageEdit> mImages;
+    std::atomic<bool> mPending{false};
+};
+
+#endif
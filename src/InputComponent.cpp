@@ -4,31 +4,48 @@
 #include "TransformComponent.h"
 
 /**
- * @brief Processes user input to update the controlled GameEntity's horizontal position.
+ * @brief Samples the keyboard into InputButton bits.
  *
  * Uses SDL_GetKeyboardState() to detect left (A or Left Arrow) and right (D or Right Arrow) key presses.
- * It then adjusts the x-coordinate of the entity's TransformComponent accordingly.
+ *
+ * @return uint8_t The buttons currently held.
+ */
+uint8_t InputComponent::ReadKeyboard()
+{
+    SDL_PumpEvents();
+    const Uint8 *keystate = SDL_GetKeyboardState(NULL);
+    uint8_t buttons = 0;
+    if (keystate[SDL_SCANCODE_A] || keystate[SDL_SCANCODE_LEFT])
+        buttons |= kButtonLeft;
+    if (keystate[SDL_SCANCODE_D] || keystate[SDL_SCANCODE_RIGHT])
+        buttons |= kButtonRight;
+    return buttons;
+}
+
+/**
+ * @brief Processes user input to update the controlled GameEntity's horizontal position.
+ *
+ * Moves the x-coordinate of the entity's TransformComponent left or right for the buttons
+ * set with SetButtons().
  * Additionally, if the associated GameEntity is a Paddle, it updates the Paddle's direction.
  *
  * @param deltaTime Time elapsed since the last frame in seconds.
  */
 void InputComponent::Input(float deltaTime)
 {
-    SDL_PumpEvents();
-    const Uint8 *keystate = SDL_GetKeyboardState(NULL);
     if (mGameEntity)
     {
-        auto trans = mGameEntity->GetComponent<TransformComponent>(ComponentType::TransformComponent);
+        auto trans = mGameEntity->GetComponent<TransformComponent>();
         if (trans)
         {
             float posX = trans->getX();
             int dir = 0;
-            if (keystate[SDL_SCANCODE_A] || keystate[SDL_SCANCODE_LEFT])
+            if (mButtons & kButtonLeft)
             {
                 posX -= mSpeed * deltaTime;
                 dir = -1;
             }
-            if (keystate[SDL_SCANCODE_D] || keystate[SDL_SCANCODE_RIGHT])
+            if (mButtons & kButtonRight)
             {
                 posX += mSpeed * deltaTime;
                 dir = 1;
@@ -42,7 +59,7 @@ void InputComponent::Input(float deltaTime)
 
             trans->move(posX, trans->getY());
 
-            auto paddle = std::dynamic_pointer_cast<Paddle>(mGameEntity);
+            auto paddle = dynamic_cast<Paddle *>(mGameEntity);
             if (paddle)
             {
                 paddle->SetDirection(dir);
@@ -54,9 +71,11 @@ void InputComponent::Input(float deltaTime)
 /**
  * @brief Sets the GameEntity associated with this InputComponent.
  *
- * @param entity Shared pointer to the GameEntity to control.
+ * The reference is non-owning; the entity owns this component.
+ *
+ * @param entity Pointer to the GameEntity to control.
  */
-void InputComponent::SetGameEntity(std::shared_ptr<GameEntity> entity)
+void InputComponent::SetGameEntity(GameEntity *entity)
 {
     mGameEntity = entity;
 }
@@ -64,9 +83,9 @@ void InputComponent::SetGameEntity(std::shared_ptr<GameEntity> entity)
 /**
  * @brief Retrieves the GameEntity associated with this InputComponent.
  *
- * @return std::shared_ptr<GameEntity> Shared pointer to the controlled GameEntity.
+ * @return GameEntity* Pointer to the controlled GameEntity.
  */
-std::shared_ptr<GameEntity> InputComponent::GetGameEntity() const
+GameEntity *InputComponent::GetGameEntity() const
 {
     return mGameEntity;
 }
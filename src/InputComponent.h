@@ -3,17 +3,33 @@
 #include "../include/ComponentType.hpp"
 #include <SDL2/SDL.h>
 #include <memory>
+#include <cstdint>
+
+/**
+ * @brief The player's buttons, as bits of one byte per simulation step.
+ */
+enum InputButton : uint8_t
+{
+    kButtonLeft = 1 << 0,
+    kButtonRight = 1 << 1,
+};
 
 /**
  * @brief InputComponent processes user input and updates the associated GameEntity.
  *
  * This component is designed for entities (such as a Paddle in a brick-breaker game)
- * that require user-controlled horizontal movement. It uses SDL_GetKeyboardState() to
- * detect the left/right arrow keys (or A/D keys) and updates the entity's TransformComponent.
+ * that require user-controlled horizontal movement. It moves the entity's TransformComponent
+ * according to the InputButton bits set for the current step, which the game samples from the
+ * keyboard with ReadKeyboard() and a replay reads from an input log.
  */
 class InputComponent : public Component
 {
 public:
+    /**
+     * @brief The slot this component occupies in a GameEntity, known at compile time.
+     */
+    static constexpr ComponentType StaticType = ComponentType::InputComponent;
+
     InputComponent();
     virtual ~InputComponent() = default;
 
@@ -24,15 +40,25 @@ public:
      *
      * @return ComponentType Returns ComponentType::InputComponent.
      */
-    virtual ComponentType GetType() const override { return ComponentType::InputComponent; }
+    virtual ComponentType GetType() const override { return StaticType; }
+
+    void SetGameEntity(GameEntity *entity) override;
+    GameEntity *GetGameEntity() const override;
+
+    /**
+     * @brief Sets the buttons held during the next Input() call.
+     *
+     * @param buttons InputButton bits.
+     */
+    void SetButtons(uint8_t buttons) { mButtons = buttons; }
 
-    void SetGameEntity(std::shared_ptr<GameEntity> entity) override;
-    std::shared_ptr<GameEntity> GetGameEntity() const override;
+    static uint8_t ReadKeyboard();
 
     float mSpeed;
 
 private:
-    std::shared_ptr<GameEntity> mGameEntity;
+    GameEntity *mGameEntity = nullptr;
+    uint8_t mButtons = 0;
 
     Uint32 mLastShotTime = 0;
     Uint32 mFireRate = 500;
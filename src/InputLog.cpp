@@ -0,0 +1,150 @@
+#include "InputLog.h"
+#include <cstring>
+#include <fstream>
+#include <iostream>
+
+namespace
+{
+    const char kLogMagic[4] = {'B', 'R', 'K', 'I'};
+    const uint32_t kLogVersion = 1;
+
+    template <typename T>
+    void WriteValue(std::ofstream &out, const T &value)
+    {
+        out.write(reinterpret_cast<const char *>(&value), sizeof(value));
+    }
+
+    template <typename T>
+    bool ReadValue(std::ifstream &in, T &value)
+    {
+        return static_cast<bool>(in.read(reinterpret_cast<char *>(&value), sizeof(value)));
+    }
+}
+
+/**
+ * @brief Starts a new recording, discarding any recorded steps.
+ *
+ * @param seed The run's seed.
+ * @param stepDelta The fixed simulation step, in seconds.
+ * @param scenes The scene files played, in order.
+ */
+void InputLog::Begin(uint64_t seed, float stepDelta, const std::vector<std::string> &scenes)
+{
+    mSeed = seed;
+    mStepDelta = stepDelta;
+    mScenes = scenes;
+    mButtons.clear();
+    mHashes.clear();
+}
+
+/**
+ * @brief Records one simulation step.
+ *
+ * @param buttons The InputButton bits fed to the step.
+ * @param stateHash Scene::StateHash() after the step.
+ */
+void InputLog::Append(uint8_t buttons, uint64_t stateHash)
+{
+    mButtons.push_back(buttons);
+    mHashes.push_back(FoldHash(stateHash));
+}
+
+/**
+ * @brief Writes the log to a file.
+ *
+ * @param path The file to create or overwrite.
+ * @return bool False if the file could not be written.
+ */
+bool InputLog::Save(const std::string &path) const
+{
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open())
+    {
+        std::cerr << "Can't create the file: " << path << std::endl;
+        return false;
+    }
+    out.write(kLogMagic, sizeof(kLogMagic));
+    WriteValue(out, kLogVersion);
+    WriteValue(out, mSeed);
+    WriteValue(out, mStepDelta);
+    WriteValue(out, static_cast<uint32_t>(mScenes.size()));
+    for (const std::string &scene : mScenes)
+    {
+        WriteValue(out, static_cast<uint32_t>(scene.size()));
+        out.write(scene.data(), scene.size());
+    }
+    WriteValue(out, static_cast<uint64_t>(mButtons.size()));
+    out.write(reinterpret_cast<const char *>(mButtons.data()), mButtons.size());
+    out.write(reinterpret_cast<const char *>(mHashes.data()), mHashes.size() * sizeof(uint32_t));
+    if (!out)
+    {
+        std::cerr << "Error writing the file: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Reads a log written by Save().
+ *
+ * @param path The log file.
+ * @return bool False if the file could not be read or is not an input log.
+ */
+bool InputLog::Load(const std::string &path)
+{
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open())
+    {
+        std::cerr << "Can't open the file: " << path << std::endl;
+        return false;
+    }
+
+    char magic[4];
+    uint32_t version = 0, sceneCount = 0;
+    if (!in.read(magic, sizeof(magic)) || std::memcmp(magic, kLogMagic, sizeof(magic)) != 0 ||
+        !ReadValue(in, version) || version != kLogVersion)
+    {
+        std::cerr << "Not an input log: " << path << std::endl;
+        return false;
+    }
+
+    // Bytes left after the current read position, so lengths can be checked before allocating.
+    auto remaining = [&in]() -> uint64_t
+    {
+        const std::streamoff start = in.tellg();
+        in.seekg(0, std::ios::end);
+        const std::streamoff left = in.tellg() - start;
+        in.seekg(start);
+        return start >= 0 && left >= 0 ? static_cast<uint64_t>(left) : 0;
+    };
+
+    uint64_t stepCount = 0;
+    bool ok = ReadValue(in, mSeed) && ReadValue(in, mStepDelta) && ReadValue(in, sceneCount);
+    mScenes.clear();
+    for (uint32_t i = 0; ok && i < sceneCount; ++i)
+    {
+        uint32_t length = 0;
+        ok = ReadValue(in, length) && length <= remaining();
+        std::string scene(ok ? length : 0, '\0');
+        ok = ok && in.read(&scene[0], length);
+        mScenes.push_back(scene);
+    }
+    ok = ok && ReadValue(in, stepCount);
+    // Bound stepCount before multiplying so a huge count cannot wrap to the real size.
+    const uint64_t stepSize = 1 + sizeof(uint32_t);
+    const uint64_t left = ok ? remaining() : 0;
+    ok = ok && stepCount <= left / stepSize && left == stepCount * stepSize;
+    if (ok)
+    {
+        mButtons.resize(stepCount);
+        mHashes.resize(stepCount);
+        ok = in.read(reinterpret_cast<char *>(mButtons.data()), stepCount) &&
+             in.read(reinterpret_cast<char *>(mHashes.data()), stepCount * sizeof(uint32_t));
+    }
+    if (!ok)
+    {
+        std::cerr << "Truncated or corrupt input log: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
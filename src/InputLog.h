@@ -0,0 +1,71 @@
+#ifndef INPUTLOG_H
+#define INPUTLOG_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @brief The InputLog class records everything needed to replay a run step by step.
+ *
+ * A run is fully determined by its scene list, its seed (each scene is seeded with
+ * MixSeed(seed, sceneIndex)), its fixed step and the buttons held on every step. The log
+ * stores those, plus the Scene::StateHash() after every step folded to 32 bits, so a replay
+ * can report the first step at which it diverges from the recording.
+ *
+ * On disk: the magic "BRKI", a version, the seed, the step, the scene list, the step count,
+ * then one button byte per step and one 32-bit hash per step; 5 bytes per step in all.
+ */
+class InputLog
+{
+public:
+    void Begin(uint64_t seed, float stepDelta, const std::vector<std::string> &scenes);
+    void Append(uint8_t buttons, uint64_t stateHash);
+    bool Save(const std::string &path) const;
+    bool Load(const std::string &path);
+
+    /**
+     * @brief Folds a 64-bit state hash to the 32 bits stored per step.
+     */
+    static uint32_t FoldHash(uint64_t stateHash) { return static_cast<uint32_t>(stateHash ^ (stateHash >> 32)); }
+
+    /**
+     * @brief Returns the run's seed.
+     */
+    uint64_t GetSeed() const { return mSeed; }
+
+    /**
+     * @brief Returns the fixed simulation step, in seconds.
+     */
+    float GetStepDelta() const { return mStepDelta; }
+
+    /**
+     * @brief Returns the scene files played, in order.
+     */
+    const std::vector<std::string> &GetScenes() const { return mScenes; }
+
+    /**
+     * @brief Returns the number of recorded steps.
+     */
+    size_t GetStepCount() const { return mButtons.size(); }
+
+    /**
+     * @brief Returns the InputButton bits fed to a step.
+     */
+    uint8_t GetButtons(size_t step) const { return mButtons[step]; }
+
+    /**
+     * @brief Returns the folded state hash recorded after a step.
+     */
+    uint32_t GetHash(size_t step) const { return mHashes[step]; }
+
+private:
+    uint64_t mSeed = 0;
+    float mStepDelta = 0.0f;
+    std::vector<std::string> mScenes;
+    std::vector<uint8_t> mButtons;
+    std::vector<uint32_t> mHashes;
+};
+
+#endif
@@ -0,0 +1,143 @@
+#include "JobSystem.h"
+#include "Profiler.h"
+#include <algorithm>
+
+/**
+ * @brief Constructs a new JobSystem object and starts its workers.
+ *
+ * @param threadCount Threads that run jobs, including the caller of ParallelFor. 1 runs everything inline.
+ */
+JobSystem::JobSystem(unsigned threadCount)
+{
+    threadCount = std::max(threadCount, 1u);
+    for (unsigned i = 0; i < threadCount; ++i)
+        mQueues.push_back(std::make_unique<Queue>());
+    for (unsigned i = 1; i < threadCount; ++i)
+        mWorkers.emplace_back(&JobSystem::WorkerLoop, this, i);
+}
+
+/**
+ * @brief Stops and joins the workers.
+ */
+JobSystem::~JobSystem()
+{
+    {
+        std::lock_guard<std::mutex> lock(mWakeMutex);
+        mStop = true;
+    }
+    mWake.notify_all();
+    for (std::thread &worker : mWorkers)
+        worker.join();
+}
+
+/**
+ * @brief Returns the hardware thread count, or 1 if it is unknown.
+ *
+ * @return unsigned The suggested thread count.
+ */
+unsigned JobSystem::DefaultThreadCount()
+{
+    return std::max(std::thread::hardware_concurrency(), 1u);
+}
+
+/**
+ * @brief Runs body over [0, count) in chunks of about grain indices and waits for all of them.
+ *
+ * Small loops (a single chunk) and single-threaded systems run inline with no synchronization.
+ * ParallelFor is not reentrant: call it from one thread at a time and not from inside a job.
+ *
+ * @param count The number of indices.
+ * @param grain The preferred chunk size.
+ * @param body Called once per chunk, possibly on several threads at once.
+ */
+void JobSystem::ParallelFor(size_t count, size_t grain, const RangeFunction &body)
+{
+    grain = std::max<size_t>(grain, 1);
+    const size_t chunks = (count + grain - 1) / grain;
+    if (chunks <= 1 || mQueues.size() == 1)
+    {
+        if (count > 0)
+            body(0, count);
+        return;
+    }
+
+    mRemaining.store(chunks, std::memory_order_relaxed);
+    {
+        // Counted before the push so a job can never be popped while mQueued is still zero.
+        std::lock_guard<std::mutex> lock(mWakeMutex);
+        mQueued.fetch_add(chunks, std::memory_order_release);
+    }
+    for (size_t chunk = 0; chunk < chunks; ++chunk)
+    {
+        Queue &queue = *mQueues[chunk % mQueues.size()];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.jobs.push_back(Job{&body, chunk * grain, std::min(count, (chunk + 1) * grain)});
+    }
+    mWake.notify_all();
+
+    while (mRemaining.load(std::memory_order_acquire) > 0)
+    {
+        if (!RunOne(0))
+            std::this_thread::yield();
+    }
+}
+
+/**
+ * @brief Runs one job: the newest of this thread's own, or else the oldest found in another queue.
+ *
+ * @param self The index of the calling thread's queue.
+ * @return bool True if a job was run.
+ */
+bool JobSystem::RunOne(size_t self)
+{
+    Job job{nullptr, 0, 0};
+    {
+        Queue &own = *mQueues[self];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.jobs.empty())
+        {
+            job = own.jobs.back();
+            own.jobs.pop_back();
+        }
+    }
+    for (size_t i = 1; !job.body && i < mQueues.size(); ++i)
+    {
+        Queue &victim = *mQueues[(self + i) % mQueues.size()];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.jobs.empty())
+        {
+            job = victim.jobs.front();
+            victim.jobs.pop_front();
+        }
+    }
+    if (!job.body)
+        return false;
+
+    mQueued.fetch_sub(1, std::memory_order_relaxed);
+    {
+        PROFILE_ZONE("Job");
+        (*job.body)(job.begin, job.end);
+    }
+    mRemaining.fetch_sub(1, std::memory_order_acq_rel);
+    return true;
+}
+
+/**
+ * @brief A worker's main loop: run jobs while there are any, sleep otherwise.
+ *
+ * @param self The index of the worker's queue.
+ */
+void JobSystem::WorkerLoop(size_t self)
+{
+    for (;;)
+    {
+        if (RunOne(self))
+            continue;
+
+        std::unique_lock<std::mutex> lock(mWakeMutex);
+        mWake.wait(lock, [this]
+                   { return mStop || mQueued.load(std::memory_order_acquire) > 0; });
+        if (mStop)
+            return;
+    }
+}
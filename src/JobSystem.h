@@ -0,0 +1,74 @@
+#ifndef JOBSYSTEM_H
+#define JOBSYSTEM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief The JobSystem class is a work-stealing thread pool for data-parallel loops.
+ *
+ * Every thread (the workers and the thread calling ParallelFor, which takes part in the
+ * work) owns a queue of jobs. A thread pops jobs from the back of its own queue and, once it
+ * is empty, steals from the front of the others, so an uneven split evens itself out.
+ *
+ * Jobs must not write to shared state except through per-index outputs; merging results
+ * that depend on order is left to the caller, after ParallelFor returns.
+ */
+class JobSystem
+{
+public:
+    /**
+     * @brief A job body: processes the index range [begin, end).
+     */
+    using RangeFunction = std::function<void(size_t begin, size_t end)>;
+
+    explicit JobSystem(unsigned threadCount);
+    ~JobSystem();
+    JobSystem(const JobSystem &) = delete;
+    JobSystem &operator=(const JobSystem &) = delete;
+
+    void ParallelFor(size_t count, size_t grain, const RangeFunction &body);
+
+    /**
+     * @brief Returns the number of threads that run jobs, including the calling thread.
+     *
+     * @return unsigned The thread count.
+     */
+    unsigned GetThreadCount() const { return static_cast<unsigned>(mQueues.size()); }
+
+    static unsigned DefaultThreadCount();
+
+private:
+    struct Job
+    {
+        const RangeFunction *body;
+        size_t begin;
+        size_t end;
+    };
+
+    struct Queue
+    {
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    bool RunOne(size_t self);
+    void WorkerLoop(size_t self);
+
+    std::vector<std::unique_ptr<Queue>> mQueues; // mQueues[0] belongs to the calling thread
+    std::vector<std::thread> mWorkers;
+    std::mutex mWakeMutex;
+    std::condition_variable mWake;
+    std::atomic<size_t> mQueued{0};
+    std::atomic<size_t> mRemaining{0};
+    bool mStop = false;
+};
+
+#endif
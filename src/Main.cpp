@@ -3,20 +3,244 @@
  * @brief The entry point for the Brick-Breaker game application.
  *
  * This file contains the main() function which initializes the application,
- * runs the main game loop, and handles application shutdown.
+ * runs the main game loop, and handles application shutdown. It also hosts the
+ * headless driver (--headless) that steps scenes without a window or renderer.
  */
 
 #include "Application.h"
+#include "Scene.h"
+#include "Benchmark.h"
+#include "Profiler.h"
+#include "SceneFile.h"
+#include "InputLog.h"
+#include "BatchRunner.h"
+#include "Random.h"
 #include <iostream>
 #include <cstdlib>
+#include <cstring>
 #include <ctime>
+#include <string>
+#include <vector>
 
-// C:\MinGW\bin\g++.exe src/main.cpp src/Application.cpp src/Scene.cpp src/Drop.cpp src/TextureComponent.cpp src/ResourceManager.cpp src/GameEntity.cpp src/Paddle.cpp src/Brick.cpp src/Ball.cpp src/InputComponent.cpp src/TransformComponent.cpp src/Collision2DComponent.cpp -I"C:\MinGW\include" -L"C:\MinGW\lib" -o bin/Brick-Breaker.exe -lmingw32 -lSDL2main -lSDL2
+// C:\MinGW\bin\g++.exe src/main.cpp src/Application.cpp src/Scene.cpp src/BrickGrid.cpp src/Drop.cpp src/TextureComponent.cpp src/ResourceManager.cpp src/GameEntity.cpp src/Paddle.cpp src/Brick.cpp src/Ball.cpp src/InputComponent.cpp src/TransformComponent.cpp src/Collision2DComponent.cpp src/ArchetypeStorage.cpp src/EntityRegistry.cpp src/RenderQueue.cpp src/FramePacer.cpp src/Profiler.cpp src/JobSystem.cpp src/SweptAABB.cpp src/AABBBatch.cpp src/SceneFile.cpp src/MappedFile.cpp src/SceneStreamer.cpp src/InputLog.cpp src/PaddleController.cpp src/BatchRunner.cpp src/VectorEnv.cpp src/StaticLayer.cpp src/BrickField.cpp src/HotReloader.cpp src/Benchmark.cpp -I"C:\MinGW\include" -L"C:\MinGW\lib" -o bin/Brick-Breaker.exe -lmingw32 -lSDL2main -lSDL2
+//
+// Add -DBRICK_PROFILE to either line to compile in the frame profiler (PROFILE_ZONE).
+//
+// Headless core library (Scene plus entities, no window/renderer required):
+// g++ -c src/Scene.cpp src/BrickGrid.cpp src/Drop.cpp src/TextureComponent.cpp src/ResourceManager.cpp src/GameEntity.cpp src/Paddle.cpp src/Brick.cpp src/Ball.cpp src/InputComponent.cpp src/TransformComponent.cpp src/Collision2DComponent.cpp src/ArchetypeStorage.cpp src/EntityRegistry.cpp src/RenderQueue.cpp src/Profiler.cpp src/JobSystem.cpp src/SweptAABB.cpp src/AABBBatch.cpp src/SceneFile.cpp src/MappedFile.cpp src/SceneStreamer.cpp src/InputLog.cpp src/PaddleController.cpp src/BatchRunner.cpp src/VectorEnv.cpp src/StaticLayer.cpp src/BrickField.cpp && ar rcs bin/libbrickcore.a *.o
+
+/**
+ * @brief Options for the headless simulation driver.
+ */
+struct HeadlessOptions
+{
+    long frames = 3600;
+    float dt = 1.0f / 60.0f;
+    std::vector<std::string> scenes;
+    std::string tracePath;
+    std::string recordPath;
+    unsigned threads = 0; // 0: one per hardware thread
+    uint64_t seed = 0;
+};
+
+/**
+ * @brief Steps scenes with a fixed timestep as fast as the CPU allows.
+ *
+ * No window or renderer is created and only the SDL timer subsystem is initialized.
+ * Ball updates are spread over a job system; the results do not depend on its thread count.
+ * Scenes are played in order, each seeded with MixSeed(seed, sceneIndex) and no buttons held;
+ * when a scene is cleared the next one is loaded, and the run stops early on game over or
+ * when the last scene is cleared. The run can be recorded to an input log for --replay.
+ *
+ * @param options Frame count, timestep, scene list, trace path, record path, thread count and seed.
+ * @return int Exit status code.
+ */
+static int RunHeadless(const HeadlessOptions &options)
+{
+    if (SDL_Init(SDL_INIT_TIMER) < 0)
+    {
+        std::cerr << "Failed to initialize SDL: " << SDL_GetError() << std::endl;
+        return 1;
+    }
+
+    JobSystem jobs(options.threads ? options.threads : JobSystem::DefaultThreadCount());
+    size_t sceneIndex = 0;
+    Scene scene;
+    scene.SetJobSystem(&jobs);
+    scene.LoadFromFile(options.scenes[sceneIndex], nullptr);
+    scene.SetSeed(MixSeed(options.seed, sceneIndex));
+
+    InputLog log;
+    log.Begin(options.seed, options.dt, options.scenes);
+    std::cout << "Seed: " << options.seed << std::endl;
+
+    long frame = 0;
+    const Uint64 start = SDL_GetPerformanceCounter();
+    for (; frame < options.frames; ++frame)
+    {
+        PROFILE_ZONE("Frame");
+        scene.Input(options.dt, 0);
+        scene.Update(options.dt);
+        if (!options.recordPath.empty())
+            log.Append(0, scene.StateHash());
+        if (scene.IsGameOver())
+        {
+            std::cout << "Game over in scene " << sceneIndex << " at frame " << frame << std::endl;
+            ++frame;
+            break;
+        }
+        if (!scene.GetSceneStatus())
+        {
+            std::cout << "Cleared scene " << sceneIndex << " at frame " << frame << std::endl;
+            if (++sceneIndex >= options.scenes.size())
+            {
+                ++frame;
+                break;
+            }
+            scene.LoadFromFile(options.scenes[sceneIndex], nullptr);
+            scene.SetSeed(MixSeed(options.seed, sceneIndex));
+        }
+    }
+    const Uint64 end = SDL_GetPerformanceCounter();
+
+    double seconds = static_cast<double>(end - start) / static_cast<double>(SDL_GetPerformanceFrequency());
+    double fps = seconds > 0.0 ? frame / seconds : 0.0;
+    std::cout << "Simulated " << frame << " frames (dt " << options.dt << "s) in " << seconds << "s: "
+              << fps << " frames/s, " << fps * options.dt << "x real time" << std::endl;
+
+    if (Profiler::kEnabled && !options.tracePath.empty())
+        Profiler::WriteChromeTrace(options.tracePath);
+    if (!options.recordPath.empty() && log.Save(options.recordPath))
+        std::cout << "Recorded " << log.GetStepCount() << " steps to " << options.recordPath << std::endl;
+
+    SDL_Quit();
+    return 0;
+}
+
+/**
+ * @brief Replays an input log headless, as fast as the CPU allows, checking every step's state.
+ *
+ * The logged scenes are played with the logged seed, step and buttons, following the same
+ * scene transitions as the game. After each step the state hash is compared with the
+ * recorded one; the replay stops at the first difference.
+ *
+ * @param path The input log written by --record.
+ * @param threads The job system's thread count (0: one per hardware thread); it does not affect the result.
+ * @return int 0 if the replay matched the recording, 1 if it diverged or the log could not be read.
+ */
+static int RunReplay(const std::string &path, unsigned threads)
+{
+    InputLog log;
+    if (!log.Load(path) || log.GetScenes().empty())
+        return 1;
+    if (SDL_Init(SDL_INIT_TIMER) < 0)
+    {
+        std::cerr << "Failed to initialize SDL: " << SDL_GetError() << std::endl;
+        return 1;
+    }
+
+    JobSystem jobs(threads ? threads : JobSystem::DefaultThreadCount());
+    const std::vector<std::string> &scenes = log.GetScenes();
+    const float dt = log.GetStepDelta();
+    size_t sceneIndex = 0;
+    Scene scene;
+    scene.SetJobSystem(&jobs);
+    scene.LoadFromFile(scenes[sceneIndex], nullptr);
+    scene.SetSeed(MixSeed(log.GetSeed(), sceneIndex));
+
+    int status = 0;
+    size_t step = 0;
+    const Uint64 start = SDL_GetPerformanceCounter();
+    for (; step < log.GetStepCount(); ++step)
+    {
+        scene.Input(dt, log.GetButtons(step));
+        scene.Update(dt);
+        const uint32_t hash = InputLog::FoldHash(scene.StateHash());
+        if (hash != log.GetHash(step))
+        {
+            std::cerr << "Replay diverged at step " << step << " in scene " << sceneIndex << ": state hash " << std::hex
+                      << hash << ", recorded " << log.GetHash(step) << std::dec << std::endl;
+            status = 1;
+            ++step;
+            break;
+        }
+        if (scene.IsGameOver())
+        {
+            ++step;
+            break;
+        }
+        if (!scene.GetSceneStatus())
+        {
+            if (++sceneIndex >= scenes.size())
+            {
+                ++step;
+                break;
+            }
+            scene.LoadFromFile(scenes[sceneIndex], nullptr);
+            scene.SetSeed(MixSeed(log.GetSeed(), sceneIndex));
+        }
+    }
+    const Uint64 end = SDL_GetPerformanceCounter();
+
+    double seconds = static_cast<double>(end - start) / static_cast<double>(SDL_GetPerformanceFrequency());
+    if (status == 0 && step < log.GetStepCount())
+    {
+        std::cerr << "Replay ended at step " << step << " of " << log.GetStepCount() << std::endl;
+        status = 1;
+    }
+    std::cout << "Replayed " << step << " steps (dt " << dt << "s) in " << seconds << "s: "
+              << (seconds > 0.0 ? step / seconds : 0.0) << " steps/s, "
+              << (status == 0 ? "every state hash matched" : "DIVERGED") << std::endl;
+
+    SDL_Quit();
+    return status;
+}
+
+/**
+ * @brief Plays a batch of scripted headless games in parallel and prints aggregated statistics.
+ *
+ * @param options The scenes, game count, per-game frame cap, timestep, seed and controller.
+ * @param threads The job system's thread count (0: one per hardware thread); it does not affect the results.
+ * @return int Exit status code.
+ */
+static int RunBatch(const BatchOptions &options, unsigned threads)
+{
+    if (SDL_Init(SDL_INIT_TIMER) < 0)
+    {
+        std::cerr << "Failed to initialize SDL: " << SDL_GetError() << std::endl;
+        return 1;
+    }
+
+    BatchRunner runner(options);
+    int status = 1;
+    if (runner.LoadScenes())
+    {
+        JobSystem jobs(threads ? threads : JobSystem::DefaultThreadCount());
+        std::cout << "Seed: " << options.seed << ", controller: " << options.controller << ", "
+                  << options.scenes.size() << " scene(s), up to " << options.maxFrames << " frames per game" << std::endl;
+        PrintBatchStats(runner.Run(jobs), jobs.GetThreadCount());
+        status = 0;
+    }
+
+    SDL_Quit();
+    return status;
+}
 
 /**
  * @brief Program entry point.
  *
  * Initializes SDL, creates an Application instance, and starts the main loop.
+ * --sim-rate HZ, --fps HZ (0 = unpaced) and --max-steps N tune the windowed loop's timing,
+ * and --scene FILE... replaces the windowed game's scene list.
+ * --trace FILE sets where a BRICK_PROFILE build writes its Chrome trace.
+ * --convert-scene IN OUT compiles a text scene into the binary scene format and exits.
+ * --seed N fixes the seed of the scenes' random generators (otherwise taken from the clock),
+ * --record FILE writes the run's input log, and --replay FILE replays one headless.
+ * --hot-reload watches the scene files and sprite images and applies their edits to the running game.
+ * --batch GAMES [--controller NAME] plays that many scripted games of the scene list in
+ * parallel (--frames caps each game, --threads sets the thread count) and prints statistics.
+ * With --headless [--frames N] [--dt X] [--threads N] [--scene FILE]... the scenes are stepped
+ * without a window instead, and --bench NAME runs an engine micro-benchmark.
  *
  * @param argc Number of command-line arguments.
  * @param argv Array of command-line argument strings.
@@ -24,9 +248,136 @@
  */
 int main(int argc, char *argv[])
 {
-    srand(time(0));
+    Profiler::RegisterMainThread();
+
+    bool headless = false;
+    std::string benchmark;
+    std::string convertIn, convertOut;
+    std::string replayPath;
+    bool seeded = false;
+    bool framesSet = false;
+    HeadlessOptions headlessOptions;
+    BatchOptions batchOptions;
+    bool batch = false;
+    bool hotReload = false;
+    LoopTiming timing;
+    for (int i = 1; i < argc; ++i)
+    {
+        if (std::strcmp(argv[i], "--headless") == 0)
+            headless = true;
+        else if (std::strcmp(argv[i], "--frames") == 0 && i + 1 < argc)
+        {
+            headlessOptions.frames = std::atol(argv[++i]);
+            framesSet = true;
+        }
+        else if (std::strcmp(argv[i], "--dt") == 0 && i + 1 < argc)
+            headlessOptions.dt = static_cast<float>(std::atof(argv[++i]));
+        else if (std::strcmp(argv[i], "--scene") == 0 && i + 1 < argc)
+            headlessOptions.scenes.push_back(argv[++i]);
+        else if (std::strcmp(argv[i], "--sim-rate") == 0 && i + 1 < argc)
+            timing.simulationRate = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--fps") == 0 && i + 1 < argc)
+            timing.frameRate = std::atof(argv[++i]);
+        else if (std::strcmp(argv[i], "--max-steps") == 0 && i + 1 < argc)
+            timing.maxStepsPerFrame = std::atoi(argv[++i]);
+        else if (std::strcmp(argv[i], "--threads") == 0 && i + 1 < argc)
+            headlessOptions.threads = static_cast<unsigned>(std::atoi(argv[++i]));
+        else if (std::strcmp(argv[i], "--trace") == 0 && i + 1 < argc)
+            headlessOptions.tracePath = argv[++i];
+        else if (std::strcmp(argv[i], "--bench") == 0 && i + 1 < argc)
+            benchmark = argv[++i];
+        else if (std::strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+        {
+            headlessOptions.seed = std::strtoull(argv[++i], nullptr, 10);
+            seeded = true;
+        }
+        else if (std::strcmp(argv[i], "--record") == 0 && i + 1 < argc)
+            headlessOptions.recordPath = argv[++i];
+        else if (std::strcmp(argv[i], "--replay") == 0 && i + 1 < argc)
+            replayPath = argv[++i];
+        else if (std::strcmp(argv[i], "--hot-reload") == 0)
+            hotReload = true;
+        else if (std::strcmp(argv[i], "--batch") == 0 && i + 1 < argc)
+        {
+            batchOptions.games = std::strtoul(argv[++i], nullptr, 10);
+            batch = true;
+        }
+        else if (std::strcmp(argv[i], "--controller") == 0 && i + 1 < argc)
+            batchOptions.controller = argv[++i];
+        else if (std::strcmp(argv[i], "--convert-scene") == 0 && i + 2 < argc)
+        {
+            convertIn = argv[++i];
+            convertOut = argv[++i];
+        }
+        else
+            std::cerr << "Ignoring unknown argument: " << argv[i] << std::endl;
+    }
+
+    if (!convertIn.empty())
+        return ConvertScene(convertIn, convertOut) ? 0 : 1;
+
+    if (!seeded)
+        headlessOptions.seed = static_cast<uint64_t>(time(0));
+
+    if (!replayPath.empty())
+        return RunReplay(replayPath, headlessOptions.threads);
+
+    if (!benchmark.empty())
+    {
+        if (SDL_Init(SDL_INIT_TIMER) < 0)
+        {
+            std::cerr << "Failed to initialize SDL: " << SDL_GetError() << std::endl;
+            return 1;
+        }
+        int status = RunBenchmark(benchmark);
+        SDL_Quit();
+        return status;
+    }
+
+    if (batch)
+    {
+        batchOptions.scenes = headlessOptions.scenes;
+        if (batchOptions.scenes.empty())
+            batchOptions.scenes = {"../Scenes/scene1.txt", "../Scenes/scene2.txt", "../Scenes/scene3.txt"};
+        if (framesSet)
+            batchOptions.maxFrames = headlessOptions.frames;
+        batchOptions.dt = headlessOptions.dt;
+        batchOptions.seed = headlessOptions.seed;
+        if (batchOptions.maxFrames <= 0 || batchOptions.dt <= 0.0f)
+        {
+            std::cerr << "--frames and --dt must be positive" << std::endl;
+            return 1;
+        }
+        return RunBatch(batchOptions, headlessOptions.threads);
+    }
+
+    if (headless)
+    {
+        if (headlessOptions.scenes.empty())
+            headlessOptions.scenes = {"../Scenes/scene1.txt", "../Scenes/scene2.txt", "../Scenes/scene3.txt"};
+        if (headlessOptions.frames <= 0 || headlessOptions.dt <= 0.0f)
+        {
+            std::cerr << "--frames and --dt must be positive" << std::endl;
+            return 1;
+        }
+        return RunHeadless(headlessOptions);
+    }
+
+    if (timing.simulationRate <= 0.0 || timing.frameRate < 0.0 || timing.maxStepsPerFrame <= 0)
+    {
+        std::cerr << "--sim-rate and --max-steps must be positive, --fps must not be negative" << std::endl;
+        return 1;
+    }
 
-    Application app;
+    Application app(timing);
+    if (!headlessOptions.tracePath.empty())
+        app.setTracePath(headlessOptions.tracePath);
+    if (!headlessOptions.scenes.empty())
+        app.setScenes(headlessOptions.scenes);
+    app.setSeed(headlessOptions.seed);
+    app.setHotReload(hotReload);
+    if (!headlessOptions.recordPath.empty())
+        app.setRecordPath(headlessOptions.recordPath);
     if (!app.init())
     {
         std::cerr << "Application initialization failed!" << std::endl;
@@ -37,4 +388,4 @@ int main(int argc, char *argv[])
     app.run();
     // std::cin.get();
     return 0;
-}
\ No newline at end of file
+}
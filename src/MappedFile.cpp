@@ -0,0 +1,115 @@
+#include "MappedFile.h"
+#include <iostream>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/**
+ * @brief Unmaps the file.
+ */
+MappedFile::~MappedFile()
+{
+    Close();
+}
+
+/**
+ * @brief Maps a file, replacing any file already mapped.
+ *
+ * An empty file opens successfully with a null Data() and a Size() of 0.
+ *
+ * @param path The file to map.
+ * @return bool True if the file was mapped, false if it could not be opened or mapped.
+ */
+bool MappedFile::Open(const std::string &path)
+{
+    Close();
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+    if (file == INVALID_HANDLE_VALUE)
+        return false;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size))
+    {
+        CloseHandle(file);
+        return false;
+    }
+    mFile = file;
+    mSize = static_cast<size_t>(size.QuadPart);
+    if (mSize == 0)
+        return true;
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (!mapping)
+    {
+        std::cerr << "Can't map " << path << ": error " << GetLastError() << std::endl;
+        Close();
+        return false;
+    }
+    mMapping = mapping;
+    mData = static_cast<const char *>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+    if (!mData)
+    {
+        std::cerr << "Can't map " << path << ": error " << GetLastError() << std::endl;
+        Close();
+        return false;
+    }
+#else
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        return false;
+    struct stat info;
+    if (fstat(fd, &info) != 0)
+    {
+        close(fd);
+        return false;
+    }
+    mSize = static_cast<size_t>(info.st_size);
+    if (mSize == 0)
+    {
+        close(fd);
+        return true;
+    }
+
+    void *data = mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd); // the mapping keeps the file alive
+    if (data == MAP_FAILED)
+    {
+        std::cerr << "Can't map " << path << std::endl;
+        mSize = 0;
+        return false;
+    }
+    madvise(data, mSize, MADV_SEQUENTIAL);
+    mData = static_cast<const char *>(data);
+#endif
+    return true;
+}
+
+/**
+ * @brief Unmaps the file. Safe to call when nothing is mapped.
+ */
+void MappedFile::Close()
+{
+#ifdef _WIN32
+    if (mData)
+        UnmapViewOfFile(mData);
+    if (mMapping)
+        CloseHandle(static_cast<HANDLE>(mMapping));
+    if (mFile)
+        CloseHandle(static_cast<HANDLE>(mFile));
+    mMapping = nullptr;
+    mFile = nullptr;
+#else
+    if (mData)
+        munmap(const_cast<char *>(mData), mSize);
+#endif
+    mData = nullptr;
+    mSize = 0;
+}
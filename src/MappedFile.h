@@ -0,0 +1,48 @@
+#ifndef MAPPEDFILE_H
+#define MAPPEDFILE_H
+
+#include <cstddef>
+#include <string>
+
+/**
+ * @brief The MappedFile class maps a whole file read-only into memory.
+ *
+ * The file's bytes are paged in by the OS on first touch instead of being copied through a
+ * read buffer. The mapping lives until Close() or destruction. Uses CreateFileMapping on
+ * Windows and mmap elsewhere.
+ */
+class MappedFile
+{
+public:
+    MappedFile() = default;
+    ~MappedFile();
+    MappedFile(const MappedFile &) = delete;
+    MappedFile &operator=(const MappedFile &) = delete;
+
+    bool Open(const std::string &path);
+    void Close();
+
+    /**
+     * @brief Returns the mapped bytes.
+     *
+     * @return const char* The start of the file, or nullptr if nothing (or an empty file) is mapped.
+     */
+    const char *Data() const { return mData; }
+
+    /**
+     * @brief Returns the size of the mapped file.
+     *
+     * @return size_t The file size in bytes.
+     */
+    size_t Size() const { return mSize; }
+
+private:
+    const char *mData = nullptr;
+    size_t mSize = 0;
+#ifdef _WIN32
+    void *mFile = nullptr;
+    void *mMapping = nullptr;
+#endif
+};
+
+#endif
@@ -27,7 +27,7 @@ Paddle::Paddle(SDL_Renderer *renderer, const char *texturePath, float speed)
  */
 void Paddle::Input(float deltaTime)
 {
-    auto inputComp = GetComponent<InputComponent>(ComponentType::InputComponent);
+    auto inputComp = GetComponent<InputComponent>();
     if (inputComp)
     {
         inputComp->Input(deltaTime);
@@ -44,7 +44,7 @@ void Paddle::Input(float deltaTime)
  */
 void Paddle::Update(float deltaTime)
 {
-    auto trans = GetComponent<TransformComponent>(ComponentType::TransformComponent);
+    auto trans = GetComponent<TransformComponent>();
     if (trans)
     {
         float currentX = trans->getX();
@@ -52,7 +52,7 @@ void Paddle::Update(float deltaTime)
         lastPosX = currentX;
     }
 
-    auto coll = GetComponent<Collision2DComponent>(ComponentType::Collision2DComponent);
+    auto coll = GetComponent<Collision2DComponent>();
     if (coll)
     {
         coll->Update(deltaTime);
@@ -0,0 +1,112 @@
+#include "PaddleController.h"
+#include "Scene.h"
+#include "InputComponent.h"
+
+/**
+ * @brief Holds no buttons.
+ *
+ * @param scene The scene about to be stepped.
+ * @return uint8_t Always 0.
+ */
+uint8_t IdleController::Decide(const Scene & /*scene*/)
+{
+    return 0;
+}
+
+/**
+ * @brief Keeps the current choice until its hold time runs out, then draws a new one.
+ *
+ * Each choice (left, right or no button) is held for 10 to 39 steps.
+ *
+ * @param scene The scene about to be stepped.
+ * @return uint8_t InputButton bits.
+ */
+uint8_t RandomController::Decide(const Scene & /*scene*/)
+{
+    if (mHoldSteps == 0)
+    {
+        static const uint8_t kChoices[] = {0, kButtonLeft, kButtonRight};
+        mButtons = kChoices[mRandom.NextBelow(3)];
+        mHoldSteps = 10 + mRandom.NextBelow(30);
+    }
+    --mHoldSteps;
+    return mButtons;
+}
+
+/**
+ * @brief Moves the paddle under the lowest ball, preferring balls that are falling.
+ *
+ * The paddle stops once its aim point is within a quarter of its width of the ball's centre.
+ *
+ * @param scene The scene about to be stepped.
+ * @return uint8_t InputButton bits.
+ */
+uint8_t TrackingController::Decide(const Scene &scene)
+{
+    if (mSteps++ % kRetargetSteps == 0)
+        mAimOffset = (static_cast<float>(mRandom.NextBelow(1001)) / 1000.0f - 0.5f) * 1.5f;
+
+    SDL_FRect paddle;
+    if (!scene.GetPaddleRect(paddle))
+        return 0;
+
+    const ArchetypeStorage &balls = scene.GetBallStorage();
+    const size_t count = balls.Size();
+    if (count == 0)
+        return 0;
+
+    // The lowest falling ball is the next one to reach the paddle; with none falling,
+    // wait under the lowest ball.
+    size_t target = count;
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (balls.mVelY[i] > 0.0f && (target == count || balls.mY[i] > balls.mY[target]))
+            target = i;
+    }
+    if (target == count)
+    {
+        target = 0;
+        for (size_t i = 1; i < count; ++i)
+        {
+            if (balls.mY[i] > balls.mY[target])
+                target = i;
+        }
+    }
+
+    const float ballX = balls.mX[target] + balls.mW[target] * 0.5f;
+    const float aimX = paddle.x + paddle.w * 0.5f * (1.0f + mAimOffset);
+    const float deadZone = paddle.w * 0.25f;
+    if (ballX < aimX - deadZone)
+        return kButtonLeft;
+    if (ballX > aimX + deadZone)
+        return kButtonRight;
+    return 0;
+}
+
+/**
+ * @brief Creates a controller by name.
+ *
+ * @param name "idle", "random" or "track".
+ * @param seed Seeds the controller's random generator.
+ * @return std::unique_ptr<PaddleController> The controller, or nullptr for an unknown name.
+ */
+std::unique_ptr<PaddleController> MakePaddleController(const std::string &name, uint64_t seed)
+{
+    if (name == "idle")
+        return std::make_unique<IdleController>(seed);
+    if (name == "random")
+        return std::make_unique<RandomController>(seed);
+    if (name == "track")
+        return std::make_unique<TrackingController>(seed);
+    return nullptr;
+}
+
+/**
+ * @brief Lists the names MakePaddleController() accepts, for error messages.
+ *
+ * @return const char* The names separated by spaces.
+ */
+const char *PaddleControllerNames()
+{
+    return "idle random track";
+}
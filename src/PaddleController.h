@@ -0,0 +1,86 @@
+#ifndef PADDLECONTROLLER_H
+#define PADDLECONTROLLER_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include "Random.h"
+
+class Scene;
+
+/**
+ * @brief The PaddleController class is a scripted player: it picks the buttons to hold each step.
+ *
+ * Controllers only look at the scene and their own state, so a game played by one is as
+ * reproducible as a replayed input log. Each controller owns a Random for any noise it adds.
+ */
+class PaddleController
+{
+public:
+    /**
+     * @brief Creates a controller.
+     *
+     * @param seed Seeds the controller's own random generator.
+     */
+    explicit PaddleController(uint64_t seed) : mRandom(seed) {}
+    virtual ~PaddleController() = default;
+
+    /**
+     * @brief Chooses the buttons to hold during the next step.
+     *
+     * @param scene The scene about to be stepped.
+     * @return uint8_t InputButton bits.
+     */
+    virtual uint8_t Decide(const Scene &scene) = 0;
+
+protected:
+    Random mRandom;
+};
+
+/**
+ * @brief Never moves the paddle.
+ */
+class IdleController : public PaddleController
+{
+public:
+    using PaddleController::PaddleController;
+    uint8_t Decide(const Scene &scene) override;
+};
+
+/**
+ * @brief Holds a random direction (or none) for a random number of steps.
+ */
+class RandomController : public PaddleController
+{
+public:
+    using PaddleController::PaddleController;
+    uint8_t Decide(const Scene &scene) override;
+
+private:
+    uint8_t mButtons = 0;
+    uint32_t mHoldSteps = 0;
+};
+
+/**
+ * @brief Follows the lowest falling ball, aiming a random distance off the paddle's centre.
+ *
+ * The aim offset is redrawn every kRetargetSteps steps, so games with different seeds
+ * return the ball at different angles instead of replaying one rally.
+ */
+class TrackingController : public PaddleController
+{
+public:
+    using PaddleController::PaddleController;
+    uint8_t Decide(const Scene &scene) override;
+
+private:
+    static constexpr uint32_t kRetargetSteps = 30;
+
+    float mAimOffset = 0.0f; // fraction of the paddle's half-width, in [-0.75, 0.75]
+    uint32_t mSteps = 0;
+};
+
+std::unique_ptr<PaddleController> MakePaddleController(const std::string &name, uint64_t seed);
+const char *PaddleControllerNames();
+
+#endif
@@ -0,0 +1,145 @@
+#include "Profiler.h"
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+thread_local ProfileBuffer *Profiler::tBuffer = nullptr;
+
+namespace
+{
+    std::mutex gBuffersMutex;
+
+    // The thread the trace labels "main"; worker zones can end before the main thread's first.
+    std::thread::id gMainThread;
+
+    // Profiler::Now() and SDL_GetPerformanceCounter() sampled together at the first zone.
+    Uint64 gCalibrationTicks = 0;
+    Uint64 gCalibrationCounter = 0;
+
+    /**
+     * @brief Every thread's buffer. Buffers outlive their threads so late exports still see them.
+     */
+    std::vector<std::unique_ptr<ProfileBuffer>> &Buffers()
+    {
+        static std::vector<std::unique_ptr<ProfileBuffer>> buffers;
+        return buffers;
+    }
+}
+
+/**
+ * @brief Creates and registers the calling thread's buffer on its first zone.
+ *
+ * @return ProfileBuffer* The new buffer.
+ */
+ProfileBuffer *Profiler::RegisterThread()
+{
+    std::lock_guard<std::mutex> lock(gBuffersMutex);
+    auto &buffers = Buffers();
+    if (buffers.empty())
+    {
+        gCalibrationTicks = Now();
+        gCalibrationCounter = SDL_GetPerformanceCounter();
+    }
+    buffers.push_back(std::make_unique<ProfileBuffer>());
+    buffers.back()->threadIndex = static_cast<uint32_t>(buffers.size() - 1);
+    buffers.back()->threadId = std::this_thread::get_id();
+    tBuffer = buffers.back().get();
+    return tBuffer;
+}
+
+/**
+ * @brief Marks the calling thread as the one the trace labels "main".
+ *
+ * Call it from the main thread before starting any thread that records zones.
+ */
+void Profiler::RegisterMainThread()
+{
+    std::lock_guard<std::mutex> lock(gBuffersMutex);
+    gMainThread = std::this_thread::get_id();
+}
+
+/**
+ * @brief Discards every recorded zone. Threads keep their buffers.
+ *
+ * Call it only while no other thread is recording.
+ */
+void Profiler::Reset()
+{
+    std::lock_guard<std::mutex> lock(gBuffersMutex);
+    for (auto &buffer : Buffers())
+        buffer->head.store(0, std::memory_order_relaxed);
+}
+
+/**
+ * @brief Writes the recorded zones as Chrome trace event JSON.
+ *
+ * Each zone becomes a complete ("X") event on the track of the thread that recorded it.
+ * Timestamps are microseconds since the earliest recorded zone. Zones still being recorded
+ * by other threads during the export may be missing; export between frames for a clean trace.
+ *
+ * @param path The output file.
+ * @return bool True if the file was written.
+ */
+bool Profiler::WriteChromeTrace(const std::string &path)
+{
+    std::lock_guard<std::mutex> lock(gBuffersMutex);
+
+    struct Span
+    {
+        uint32_t head;
+        uint32_t count;
+    };
+    std::vector<Span> spans;
+    Uint64 origin = UINT64_MAX;
+    for (auto &buffer : Buffers())
+    {
+        const uint32_t head = buffer->head.load(std::memory_order_acquire);
+        const uint32_t count = std::min(head, ProfileBuffer::kCapacity);
+        spans.push_back(Span{head, count});
+        for (uint32_t i = head - count; i != head; ++i)
+            origin = std::min(origin, buffer->events[i & (ProfileBuffer::kCapacity - 1)].start);
+    }
+
+    std::ofstream out(path);
+    if (!out)
+    {
+        SDL_Log("Could not write profile trace %s", path.c_str());
+        return false;
+    }
+
+    // Profiler ticks per second, measured over the whole run so far.
+    const double counterSeconds = static_cast<double>(SDL_GetPerformanceCounter() - gCalibrationCounter) /
+                                  static_cast<double>(SDL_GetPerformanceFrequency());
+    const Uint64 ticks = Now() - gCalibrationTicks;
+    const double ticksPerSecond = counterSeconds > 0.0 && ticks > 0 ? static_cast<double>(ticks) / counterSeconds
+                                                                     : static_cast<double>(SDL_GetPerformanceFrequency());
+    const double toMicroseconds = 1e6 / ticksPerSecond;
+    bool first = true;
+    out << "{\"traceEvents\":[";
+    for (size_t b = 0; b < Buffers().size(); ++b)
+    {
+        const ProfileBuffer &buffer = *Buffers()[b];
+        out << (first ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer.threadIndex
+            << ",\"args\":{\"name\":\"";
+        if (buffer.threadId == gMainThread)
+            out << "main";
+        else
+            out << "thread " << buffer.threadIndex;
+        out << "\"}}";
+        first = false;
+
+        for (uint32_t i = spans[b].head - spans[b].count; i != spans[b].head; ++i)
+        {
+            const ProfileEvent &event = buffer.events[i & (ProfileBuffer::kCapacity - 1)];
+            out << ",\n{\"name\":\"" << event.name << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer.threadIndex
+                << ",\"ts\":" << (event.start - origin) * toMicroseconds
+                << ",\"dur\":" << (event.end - event.start) * toMicroseconds << "}";
+        }
+    }
+    out << "\n]}\n";
+
+    SDL_Log("Wrote profile trace %s", path.c_str());
+    return static_cast<bool>(out);
+}
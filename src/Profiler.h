@@ -0,0 +1,128 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <SDL2/SDL.h>
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#define PROFILER_HAS_TSC 1
+#elif defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#define PROFILER_HAS_TSC 1
+#endif
+
+/**
+ * @brief One completed zone: a name and its start and end Profiler::Now() ticks.
+ */
+struct ProfileEvent
+{
+    const char *name;
+    Uint64 start;
+    Uint64 end;
+};
+
+/**
+ * @brief A thread's ring of recent zones. Only the owning thread writes to it.
+ */
+struct ProfileBuffer
+{
+    static constexpr uint32_t kCapacity = 1u << 16; // must be a power of two
+
+    ProfileEvent events[kCapacity];
+    std::atomic<uint32_t> head{0};
+    uint32_t threadIndex = 0;
+    std::thread::id threadId;
+};
+
+/**
+ * @brief The Profiler class collects scoped zones into per-thread ring buffers.
+ *
+ * Recording a zone is two timestamp reads and one store into the calling thread's buffer: no
+ * locks, no allocation. On x86 the timestamp is the CPU time-stamp counter, which is cheaper
+ * to read than SDL_GetPerformanceCounter(); it is converted to time at export by calibrating
+ * it against the performance counter. Each buffer keeps the most recent ProfileBuffer::kCapacity zones.
+ * WriteChromeTrace() exports them as Chrome trace event JSON, which chrome://tracing and
+ * Perfetto open directly.
+ *
+ * Zones are placed with PROFILE_ZONE("name"), which compiles to nothing unless the build
+ * defines BRICK_PROFILE. Zone names must be string literals (only the pointer is stored).
+ */
+class Profiler
+{
+public:
+#ifdef BRICK_PROFILE
+    static constexpr bool kEnabled = true;
+#else
+    static constexpr bool kEnabled = false;
+#endif
+
+    /**
+     * @brief Returns the current profiler timestamp.
+     *
+     * @return Uint64 Ticks of the time-stamp counter, or of SDL_GetPerformanceCounter() off x86.
+     */
+    static Uint64 Now()
+    {
+#ifdef PROFILER_HAS_TSC
+        return __rdtsc();
+#else
+        return SDL_GetPerformanceCounter();
+#endif
+    }
+
+    /**
+     * @brief Appends a zone to the calling thread's ring buffer.
+     *
+     * @param name The zone name; a string literal.
+     * @param start The zone's starting Now() value.
+     * @param end The zone's ending Now() value.
+     */
+    static void Record(const char *name, Uint64 start, Uint64 end)
+    {
+        ProfileBuffer *buffer = tBuffer ? tBuffer : RegisterThread();
+        const uint32_t head = buffer->head.load(std::memory_order_relaxed);
+        buffer->events[head & (ProfileBuffer::kCapacity - 1)] = ProfileEvent{name, start, end};
+        buffer->head.store(head + 1, std::memory_order_release);
+    }
+
+    static void RegisterMainThread();
+    static bool WriteChromeTrace(const std::string &path);
+    static void Reset();
+
+private:
+    static ProfileBuffer *RegisterThread();
+
+    static thread_local ProfileBuffer *tBuffer;
+};
+
+/**
+ * @brief Records the lifetime of a scope as a profiler zone.
+ */
+class ProfileZone
+{
+public:
+    explicit ProfileZone(const char *name) : mName(name), mStart(Profiler::Now()) {}
+    ~ProfileZone() { Profiler::Record(mName, mStart, Profiler::Now()); }
+
+    ProfileZone(const ProfileZone &) = delete;
+    ProfileZone &operator=(const ProfileZone &) = delete;
+
+private:
+    const char *mName;
+    Uint64 mStart;
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#ifdef BRICK_PROFILE
+#define PROFILE_ZONE(name) ProfileZone PROFILE_CONCAT(profileZone, __LINE__)(name)
+#else
+#define PROFILE_ZONE(name) ((void)0)
+#endif
+
+#endif
@@ -0,0 +1,77 @@
+#ifndef RANDOM_H
+#define RANDOM_H
+
+#include <cstdint>
+
+/**
+ * @brief The Random class is a small seeded pseudo-random generator (SplitMix64).
+ *
+ * Each Scene owns one instead of sharing the C library's global rand(), so a scene's
+ * random choices depend only on its seed and on what happened in it, never on other
+ * scenes, threads or library code drawing numbers in between.
+ */
+class Random
+{
+public:
+    /**
+     * @brief Creates a generator with a given seed.
+     *
+     * @param seed The seed; equal seeds give equal sequences.
+     */
+    explicit Random(uint64_t seed = 0) : mState(seed) {}
+
+    /**
+     * @brief Restarts the sequence from a seed.
+     *
+     * @param seed The seed.
+     */
+    void Seed(uint64_t seed) { mState = seed; }
+
+    /**
+     * @brief Returns the generator's state, e.g. to include in a state hash.
+     *
+     * @return uint64_t The state; equal states produce equal sequences.
+     */
+    uint64_t GetState() const { return mState; }
+
+    /**
+     * @brief Returns the next 32 random bits.
+     *
+     * @return uint32_t A uniformly distributed value.
+     */
+    uint32_t Next()
+    {
+        uint64_t z = (mState += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return static_cast<uint32_t>((z ^ (z >> 31)) >> 32);
+    }
+
+    /**
+     * @brief Returns a random integer in [0, bound).
+     *
+     * Uses a multiply and shift rather than a modulo; the bias is below 2^-32 * bound.
+     *
+     * @param bound The exclusive upper bound, at least 1.
+     * @return uint32_t The value.
+     */
+    uint32_t NextBelow(uint32_t bound) { return static_cast<uint32_t>((static_cast<uint64_t>(Next()) * bound) >> 32); }
+
+private:
+    uint64_t mState;
+};
+
+/**
+ * @brief Derives an independent seed for one of several streams (e.g. the scenes of a run) from a base seed.
+ *
+ * @param seed The base seed.
+ * @param stream The stream number.
+ * @return uint64_t The stream's seed.
+ */
+inline uint64_t MixSeed(uint64_t seed, uint64_t stream)
+{
+    Random mixer(seed ^ (stream * 0xD1B54A32D192ED03ull));
+    return (static_cast<uint64_t>(mixer.Next()) << 32) | mixer.Next();
+}
+
+#endif
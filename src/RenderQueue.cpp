@@ -0,0 +1,118 @@
+#include "RenderQueue.h"
+#include "Profiler.h"
+#include <algorithm>
+
+/**
+ * @brief Discards everything queued since the last Flush().
+ */
+void RenderQueue::Clear()
+{
+    mQuads.clear();
+}
+
+/**
+ * @brief Queues a sprite that shows its whole texture.
+ *
+ * @param layer Draw order group; lower layers are drawn first.
+ * @param texture The sprite's texture. Null textures are skipped.
+ * @param dst The destination rectangle.
+ */
+void RenderQueue::AddSprite(uint8_t layer, SDL_Texture *texture, const SDL_FRect &dst)
+{
+    AddSprite(layer, texture, dst, SDL_FRect{0.0f, 0.0f, 1.0f, 1.0f});
+}
+
+/**
+ * @brief Queues a sprite that shows part of its texture.
+ *
+ * @param layer Draw order group; lower layers are drawn first.
+ * @param texture The sprite's texture. Null textures are skipped.
+ * @param dst The destination rectangle.
+ * @param uv The source region in normalized texture coordinates (x, y, width, height).
+ */
+void RenderQueue::AddSprite(uint8_t layer, SDL_Texture *texture, const SDL_FRect &dst, const SDL_FRect &uv)
+{
+    if (!texture)
+        return;
+    AddQuad(layer, texture, dst, uv, SDL_Color{255, 255, 255, 255});
+}
+
+/**
+ * @brief Queues a one-pixel rectangle outline, the batched form of SDL_RenderDrawRectF.
+ *
+ * @param layer Draw order group; lower layers are drawn first.
+ * @param rect The rectangle to outline.
+ * @param color The outline colour.
+ */
+void RenderQueue::AddOutline(uint8_t layer, const SDL_FRect &rect, SDL_Color color)
+{
+    const SDL_FRect noUV{0, 0, 0, 0};
+    AddQuad(layer, nullptr, SDL_FRect{rect.x, rect.y, rect.w, 1.0f}, noUV, color);
+    AddQuad(layer, nullptr, SDL_FRect{rect.x, rect.y + rect.h - 1.0f, rect.w, 1.0f}, noUV, color);
+    AddQuad(layer, nullptr, SDL_FRect{rect.x, rect.y + 1.0f, 1.0f, rect.h - 2.0f}, noUV, color);
+    AddQuad(layer, nullptr, SDL_FRect{rect.x + rect.w - 1.0f, rect.y + 1.0f, 1.0f, rect.h - 2.0f}, noUV, color);
+}
+
+/**
+ * @brief Sorts the queued quads and draws them in batches.
+ *
+ * The queue is empty afterwards; GetDrawCalls() reports the number of submissions.
+ *
+ * @param renderer The SDL_Renderer used for drawing.
+ */
+void RenderQueue::Flush(SDL_Renderer *renderer)
+{
+    PROFILE_ZONE("RenderQueue::Flush");
+    mDrawCalls = 0;
+    mQuadCount = mQuads.size();
+
+    std::stable_sort(mQuads.begin(), mQuads.end(), [](const Quad &a, const Quad &b)
+                     {
+                         if (a.layer != b.layer)
+                             return a.layer < b.layer;
+                         return std::less<SDL_Texture *>()(a.texture, b.texture);
+                     });
+
+    mVertices.clear();
+    mIndices.clear();
+    SDL_Texture *batchTexture = nullptr;
+    for (const Quad &quad : mQuads)
+    {
+        if (!mVertices.empty() && quad.texture != batchTexture)
+            Submit(renderer, batchTexture);
+        batchTexture = quad.texture;
+
+        const int base = static_cast<int>(mVertices.size());
+        const float x0 = quad.dst.x, y0 = quad.dst.y, x1 = quad.dst.x + quad.dst.w, y1 = quad.dst.y + quad.dst.h;
+        const float u0 = quad.uv.x, v0 = quad.uv.y, u1 = quad.uv.x + quad.uv.w, v1 = quad.uv.y + quad.uv.h;
+        mVertices.push_back(SDL_Vertex{SDL_FPoint{x0, y0}, quad.color, SDL_FPoint{u0, v0}});
+        mVertices.push_back(SDL_Vertex{SDL_FPoint{x1, y0}, quad.color, SDL_FPoint{u1, v0}});
+        mVertices.push_back(SDL_Vertex{SDL_FPoint{x1, y1}, quad.color, SDL_FPoint{u1, v1}});
+        mVertices.push_back(SDL_Vertex{SDL_FPoint{x0, y1}, quad.color, SDL_FPoint{u0, v1}});
+        mIndices.insert(mIndices.end(), {base, base + 1, base + 2, base, base + 2, base + 3});
+    }
+    if (!mVertices.empty())
+        Submit(renderer, batchTexture);
+
+    mQuads.clear();
+}
+
+/**
+ * @brief Appends one quad to the queue.
+ */
+void RenderQueue::AddQuad(uint8_t layer, SDL_Texture *texture, const SDL_FRect &dst, const SDL_FRect &uv, SDL_Color color)
+{
+    mQuads.push_back(Quad{texture, dst, uv, color, layer});
+}
+
+/**
+ * @brief Draws the accumulated vertices with one SDL_RenderGeometry call and resets the batch.
+ */
+void RenderQueue::Submit(SDL_Renderer *renderer, SDL_Texture *texture)
+{
+    SDL_RenderGeometry(renderer, texture, mVertices.data(), static_cast<int>(mVertices.size()),
+                       mIndices.data(), static_cast<int>(mIndices.size()));
+    mDrawCalls++;
+    mVertices.clear();
+    mIndices.clear();
+}
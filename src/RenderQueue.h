@@ -0,0 +1,61 @@
+#ifndef RENDERQUEUE_H
+#define RENDERQUEUE_H
+
+#include <vector>
+#include <cstdint>
+#include <cstddef>
+#include <SDL2/SDL.h>
+
+/**
+ * @brief The RenderQueue class batches a frame's sprites into a few SDL_RenderGeometry calls.
+ *
+ * Sprites and debug outlines are collected during the frame, then Flush() sorts them by
+ * layer and texture and emits one SDL_RenderGeometry call per run of sprites sharing a
+ * texture. Layers keep the back-to-front order between groups (e.g. bricks under drops);
+ * within a layer the order follows the texture. Outlines are untextured quads, so all of a
+ * layer's debug boxes go out in a single call with no per-rectangle colour changes.
+ */
+class RenderQueue
+{
+public:
+    void Clear();
+    void AddSprite(uint8_t layer, SDL_Texture *texture, const SDL_FRect &dst);
+    void AddSprite(uint8_t layer, SDL_Texture *texture, const SDL_FRect &dst, const SDL_FRect &uv);
+    void AddOutline(uint8_t layer, const SDL_FRect &rect, SDL_Color color);
+    void Flush(SDL_Renderer *renderer);
+
+    /**
+     * @brief Returns the number of SDL_RenderGeometry calls issued by the last Flush().
+     *
+     * @return int The draw call count.
+     */
+    int GetDrawCalls() const { return mDrawCalls; }
+
+    /**
+     * @brief Returns the number of quads submitted by the last Flush().
+     *
+     * @return size_t The quad count (sprites plus outline edges).
+     */
+    size_t GetQuadCount() const { return mQuadCount; }
+
+private:
+    struct Quad
+    {
+        SDL_Texture *texture;
+        SDL_FRect dst;
+        SDL_FRect uv;
+        SDL_Color color;
+        uint8_t layer;
+    };
+
+    void AddQuad(uint8_t layer, SDL_Texture *texture, const SDL_FRect &dst, const SDL_FRect &uv, SDL_Color color);
+    void Submit(SDL_Renderer *renderer, SDL_Texture *texture);
+
+    std::vector<Quad> mQuads;
+    std::vector<SDL_Vertex> mVertices;
+    std::vector<int> mIndices;
+    int mDrawCalls = 0;
+    size_t mQuadCount = 0;
+};
+
+#endif
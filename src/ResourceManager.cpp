@@ -1,80 +1,434 @@
-#include <string>
-#include <unordered_map>
-#include <iostream>
-#include "../include/ResourceManager.hpp"
+#include "ResourceManager.h"
+#include <algorithm>
 
-// Initialize our static member variable.
-ResourceManager *ResourceManager::mInstance = nullptr;
+/**
+ * @brief Returns the sprite images shipped in Assets/, the set packed into the atlas at startup.
+ *
+ * Paths are relative to bin/, matching the paths used by scene files and entities.
+ *
+ * @return const std::vector<std::string>& The BMP paths.
+ */
+const std::vector<std::string> &SpriteAssetPaths()
+{
+    static const std::vector<std::string> paths = {
+        "../Assets/ball.bmp", "../Assets/brick.bmp", "../Assets/unbrick.bmp", "../Assets/drop.bmp",
+        "../Assets/paddle.bmp", "../Assets/Projectile.bmp", "../Assets/Alien.bmp", "../Assets/Spaceship.bmp"};
+    return paths;
+}
 
 /**
- * @brief A custom deleter functor for SDL_Texture.
+ * @brief Interns an asset path.
+ *
+ * The first call for a path assigns it a new AssetId; later calls return the same id.
+ * Callers are expected to intern once (e.g. at scene load) and keep the id.
  *
- * This functor ensures that SDL_DestroyTexture is called when the shared pointer
- * managing an SDL_Texture goes out of scope.
+ * @param filePath The file path of the asset.
+ * @return AssetId The interned id, or kInvalidAsset if the id space is exhausted.
  */
-struct TextureFunctorDeleter
+AssetId ResourceManager::Intern(const std::string &filePath)
 {
-    void operator()(SDL_Texture *texture) const
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto found = mIds.find(filePath);
+    if (found != mIds.end())
+        return found->second;
+
+    const size_t count = mEntryCount.load(std::memory_order_relaxed);
+    if (count >= kInvalidAsset)
     {
-        SDL_DestroyTexture(texture);
+        SDL_Log("Too many assets, cannot intern: %s", filePath.c_str());
+        return kInvalidAsset;
     }
-};
+    AssetId id = static_cast<AssetId>(count);
+    if (!mChunks[id / kChunkSize])
+        mChunks[id / kChunkSize] = std::make_unique<Entry[]>(kChunkSize);
+    At(id).path = filePath;
+    mIds.emplace(filePath, id);
+    mEntryCount.store(count + 1, std::memory_order_release);
+    return id;
+}
 
 /**
- * @brief Creates a shared pointer to an SDL_Texture from an SDL_Surface.
+ * @brief Loads a texture through the cache.
  *
- * Creates an SDL_Texture from the given surface and returns it as a shared pointer
- * with a custom deleter (TextureFunctorDeleter). If texture creation fails, returns nullptr.
+ * The BMP is read from disk only the first time; the texture is created once per renderer.
+ * With a null renderer only the image is decoded: its size is recorded, so headless scenes
+ * still get correct entity sizes without touching the video subsystem, and its pixels are
+ * kept for a later load with a renderer to upload. The decode runs outside the cache lock,
+ * so a worker thread loading a scene does not stall the render thread.
  *
- * @param renderer The SDL_Renderer used to create the texture.
- * @param pixels The SDL_Surface containing the image data.
- * @return std::shared_ptr<SDL_Texture> The shared pointer managing the created texture.
+ * @param id The interned asset id.
+ * @param renderer The SDL_Renderer used to create the texture, or nullptr when headless.
+ * @return TextureHandle A handle to the cached texture, or an invalid handle on error.
  */
-std::shared_ptr<SDL_Texture> ResourceManager::make_shared_texture(SDL_Renderer *renderer, SDL_Surface *pixels)
+TextureHandle ResourceManager::LoadTexture(AssetId id, SDL_Renderer *renderer)
 {
-    SDL_Texture *pTexture = SDL_CreateTextureFromSurface(renderer, pixels);
+    if (id >= mEntryCount.load(std::memory_order_acquire))
+        return TextureHandle{};
+
+    Entry &entry = At(id);
+    SDL_Surface *pixels = nullptr;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        if (entry.loaded && (entry.renderer == renderer || !renderer))
+            return TextureHandle{id};
+        std::swap(pixels, entry.pixels);
+    }
 
-    if (pTexture == nullptr)
+    if (!pixels)
     {
-        SDL_Log("Could not load texture from surface.");
+        pixels = SDL_LoadBMP(entry.path.c_str());
+        if (!pixels)
+        {
+            SDL_Log("Failed to load image %s: %s", entry.path.c_str(), SDL_GetError());
+            return TextureHandle{};
+        }
     }
 
-    return std::shared_ptr<SDL_Texture>(pTexture, TextureFunctorDeleter());
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (entry.loaded && (entry.renderer == renderer || !renderer))
+    {
+        // Another thread finished the same load while this one was decoding.
+        SDL_FreeSurface(pixels);
+        return TextureHandle{id};
+    }
+
+    if (entry.texture && !entry.inAtlas)
+        SDL_DestroyTexture(entry.texture);
+    entry.texture = nullptr;
+    entry.inAtlas = false;
+    entry.uv = SDL_FRect{0, 0, 1, 1};
+    SetSize(entry, pixels->w, pixels->h);
+    if (renderer)
+    {
+        entry.texture = SDL_CreateTextureFromSurface(renderer, pixels);
+        if (!entry.texture)
+            SDL_Log("Could not create texture for %s: %s", entry.path.c_str(), SDL_GetError());
+        SDL_FreeSurface(pixels);
+    }
+    else
+    {
+        if (entry.pixels)
+            SDL_FreeSurface(entry.pixels);
+        entry.pixels = pixels;
+    }
+    entry.renderer = renderer;
+    entry.loaded = true;
+
+    return TextureHandle{id};
 }
 
 /**
- * @brief Loads a texture from a BMP file.
+ * @brief Records an image's size, writing only when it changes.
  *
- * Checks if the texture specified by filePath is already loaded in the cache.
- * If it is, the cached texture is returned. Otherwise, the BMP is loaded from file,
- * a texture is created, stored in the cache, and then returned.
+ * Other threads read the size without the lock, so an unchanged size must not be rewritten.
+ * The caller must hold mMutex.
+ */
+void ResourceManager::SetSize(Entry &entry, int width, int height)
+{
+    if (entry.width != width)
+        entry.width = width;
+    if (entry.height != height)
+        entry.height = height;
+}
+
+/**
+ * @brief Interns a path and loads its texture through the cache.
  *
  * @param filePath The file path to the BMP image.
- * @param renderer The SDL_Renderer used to create the texture.
- * @return std::shared_ptr<SDL_Texture> The shared pointer to the loaded texture, or nullptr on error.
+ * @param renderer The SDL_Renderer used to create the texture, or nullptr when headless.
+ * @return TextureHandle A handle to the cached texture, or an invalid handle on error.
+ */
+TextureHandle ResourceManager::LoadTexture(const std::string &filePath, SDL_Renderer *renderer)
+{
+    AssetId id = Intern(filePath);
+    if (id == kInvalidAsset)
+        return TextureHandle{};
+    return LoadTexture(id, renderer);
+}
+
+/**
+ * @brief Packs images into one atlas texture.
+ *
+ * The images are sorted by height and placed on shelves with a one pixel gutter; the
+ * atlas is a power of two wide and high. Every packed image's entry then points at the
+ * atlas and records its sub-rectangle, replacing any standalone texture it had. Images
+ * that fail to load are logged and left out. Building a new atlas replaces the old one.
+ *
+ * @param filePaths The BMP images to pack.
+ * @param renderer The SDL_Renderer used to create the atlas. Headless (nullptr) builds nothing.
+ * @return bool True if the atlas was created.
  */
-std::shared_ptr<SDL_Texture> ResourceManager::LoadTexture(SDL_Renderer *renderer, std::string filePath)
+bool ResourceManager::BuildAtlas(const std::vector<std::string> &filePaths, SDL_Renderer *renderer)
 {
-    std::cout << "File Path in Load Texture" << filePath << std::endl;
-    // Check if texture is already loaded
-    if (mTextures.find(filePath) != mTextures.end())
+    if (!renderer)
+        return false;
+
+    std::vector<AssetId> ids;
+    for (const std::string &path : filePaths)
     {
-        std::cout << "Reusing Texture: " << mTextures[filePath].get() << std::endl;
-        return mTextures[filePath];
+        AssetId id = Intern(path);
+        if (id != kInvalidAsset)
+            ids.push_back(id);
     }
 
-    // Load BMP file
-    SDL_Surface *pixels = SDL_LoadBMP(filePath.c_str());
-    if (!pixels)
+    std::lock_guard<std::mutex> lock(mMutex);
+
+    struct Sprite
+    {
+        AssetId id;
+        SDL_Surface *pixels;
+        SDL_Rect rect;
+    };
+    std::vector<Sprite> sprites;
+    int widest = 0;
+    for (AssetId id : ids)
+    {
+        SDL_Surface *pixels = SDL_LoadBMP(At(id).path.c_str());
+        if (!pixels)
+        {
+            SDL_Log("Failed to load image %s: %s", At(id).path.c_str(), SDL_GetError());
+            continue;
+        }
+        sprites.push_back(Sprite{id, pixels, SDL_Rect{0, 0, pixels->w, pixels->h}});
+        widest = std::max(widest, pixels->w);
+    }
+    if (sprites.empty())
+        return false;
+
+    std::stable_sort(sprites.begin(), sprites.end(), [](const Sprite &a, const Sprite &b)
+                     { return a.rect.h > b.rect.h; });
+
+    const int gutter = 1;
+    int width = 64;
+    while (width < widest + 2 * gutter)
+        width *= 2;
+
+    int x = gutter, y = gutter, shelfHeight = 0;
+    for (Sprite &sprite : sprites)
+    {
+        if (x + sprite.rect.w + gutter > width)
+        {
+            x = gutter;
+            y += shelfHeight + gutter;
+            shelfHeight = 0;
+        }
+        sprite.rect.x = x;
+        sprite.rect.y = y;
+        x += sprite.rect.w + gutter;
+        shelfHeight = std::max(shelfHeight, sprite.rect.h);
+    }
+    int height = 64;
+    while (height < y + shelfHeight + gutter)
+        height *= 2;
+
+    SDL_Surface *atlas = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_ARGB8888);
+    SDL_Texture *texture = nullptr;
+    if (atlas)
+    {
+        for (Sprite &sprite : sprites)
+        {
+            SDL_SetSurfaceBlendMode(sprite.pixels, SDL_BLENDMODE_NONE);
+            SDL_Rect dst = sprite.rect;
+            SDL_BlitSurface(sprite.pixels, nullptr, atlas, &dst);
+        }
+        texture = SDL_CreateTextureFromSurface(renderer, atlas);
+        SDL_FreeSurface(atlas);
+    }
+    if (!texture)
+        SDL_Log("Could not create texture atlas: %s", SDL_GetError());
+
+    if (texture)
+    {
+        ReleaseAtlas();
+        mAtlasTexture = texture;
+        mAtlasWidth = width;
+        mAtlasHeight = height;
+        for (const Sprite &sprite : sprites)
+        {
+            Entry &entry = At(sprite.id);
+            if (entry.texture && !entry.inAtlas)
+                SDL_DestroyTexture(entry.texture);
+            if (entry.pixels)
+                SDL_FreeSurface(entry.pixels);
+            entry.pixels = nullptr;
+            entry.texture = texture;
+            entry.renderer = renderer;
+            SetSize(entry, sprite.rect.w, sprite.rect.h);
+            entry.loaded = true;
+            entry.inAtlas = true;
+            entry.atlasRect = sprite.rect;
+            entry.uv = SDL_FRect{static_cast<float>(sprite.rect.x) / width, static_cast<float>(sprite.rect.y) / height,
+                                 static_cast<float>(sprite.rect.w) / width, static_cast<float>(sprite.rect.h) / height};
+        }
+    }
+
+    for (Sprite &sprite : sprites)
+        SDL_FreeSurface(sprite.pixels);
+    return texture != nullptr;
+}
+
+/**
+ * @brief Replaces a cached image's pixels with a new version of its file, in place.
+ *
+ * Used by hot reload. The image's texture, or its rectangle in the atlas, is overwritten
+ * with SDL_UpdateTexture(), so handles, entity sizes and batching are unaffected. An image
+ * decoded but not yet uploaded has its pending pixels swapped instead. Only a same-sized
+ * image can be applied: sizes are read without the lock and never change once known.
+ *
+ * Must be called on the render thread.
+ *
+ * @param filePath The image's path, as it was interned.
+ * @param pixels The new image; the cache takes ownership and frees it.
+ * @return bool True if a cached image was updated; false if the path was never loaded,
+ * the size changed or the upload failed.
+ */
+bool ResourceManager::ReloadTexture(const std::string &filePath, SDL_Surface *pixels)
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    auto found = mIds.find(filePath);
+    Entry *entry = found != mIds.end() ? &At(found->second) : nullptr;
+    if (!entry || !entry->loaded)
     {
-        SDL_Log("Failed to load image: %s", SDL_GetError());
-        return nullptr;
+        SDL_FreeSurface(pixels);
+        return false;
     }
+    if (pixels->w != entry->width || pixels->h != entry->height)
+    {
+        SDL_Log("Cannot reload %s: size changed from %dx%d to %dx%d, restart to apply it", filePath.c_str(),
+                entry->width, entry->height, pixels->w, pixels->h);
+        SDL_FreeSurface(pixels);
+        return false;
+    }
+    if (!entry->texture)
+    {
+        if (entry->pixels)
+            SDL_FreeSurface(entry->pixels);
+        entry->pixels = pixels;
+        return true;
+    }
+
+    Uint32 format = SDL_PIXELFORMAT_ARGB8888;
+    SDL_QueryTexture(entry->texture, &format, nullptr, nullptr, nullptr);
+    SDL_Surface *converted = SDL_ConvertSurfaceFormat(pixels, format, 0);
+    SDL_FreeSurface(pixels);
+    const SDL_Rect rect = entry->inAtlas ? entry->atlasRect : SDL_Rect{0, 0, entry->width, entry->height};
+    const bool updated = converted && SDL_UpdateTexture(entry->texture, &rect, converted->pixels, converted->pitch) == 0;
+    if (!updated)
+        SDL_Log("Could not reload texture for %s: %s", filePath.c_str(), SDL_GetError());
+    if (converted)
+        SDL_FreeSurface(converted);
+    return updated;
+}
 
-    std::shared_ptr<SDL_Texture> texture = make_shared_texture(renderer, pixels);
-    mTextures[filePath] = texture;
-    SDL_FreeSurface(pixels); // Free the surface as it's no longer needed
-    std::cout << "Creating New Texture: " << mTextures[filePath].get() << std::endl;
+/**
+ * @brief Destroys the atlas texture and detaches the entries that pointed at it.
+ *
+ * The detached entries are marked unloaded, so the next LoadTexture() reloads them from disk.
+ * The caller must hold mMutex.
+ */
+void ResourceManager::ReleaseAtlas()
+{
+    const size_t count = mEntryCount.load(std::memory_order_relaxed);
+    for (size_t id = 0; id < count; ++id)
+    {
+        Entry &entry = At(static_cast<AssetId>(id));
+        if (!entry.inAtlas)
+            continue;
+        entry.texture = nullptr;
+        entry.renderer = nullptr;
+        entry.loaded = false;
+        entry.inAtlas = false;
+        entry.uv = SDL_FRect{0, 0, 1, 1};
+    }
+    if (mAtlasTexture)
+        SDL_DestroyTexture(mAtlasTexture);
+    mAtlasTexture = nullptr;
+    mAtlasWidth = 0;
+    mAtlasHeight = 0;
+}
 
-    return texture;
+/**
+ * @brief Returns the path an AssetId was interned from.
+ *
+ * @param id The asset id.
+ * @return const std::string& The path, or an empty string for an unknown id.
+ */
+const std::string &ResourceManager::GetPath(AssetId id) const
+{
+    static const std::string empty;
+    return id < mEntryCount.load(std::memory_order_acquire) ? At(id).path : empty;
+}
+
+/**
+ * @brief Returns the number and estimated size of all loaded textures.
+ *
+ * @return TextureStats Texture count and bytes, assuming 4 bytes per pixel.
+ */
+TextureStats ResourceManager::GetStats() const
+{
+    std::vector<TextureHandle> all;
+    const size_t count = mEntryCount.load(std::memory_order_acquire);
+    for (size_t id = 0; id < count; ++id)
+        all.push_back(TextureHandle{static_cast<AssetId>(id)});
+    return GetStats(all);
+}
+
+/**
+ * @brief Returns the number and estimated size of the distinct textures in a set of handles.
+ *
+ * @param handles The handles to account for; duplicates, and images sharing the atlas, are counted once.
+ * @return TextureStats Texture count and bytes, assuming 4 bytes per pixel.
+ */
+TextureStats ResourceManager::GetStats(const std::vector<TextureHandle> &handles) const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    TextureStats stats;
+    const size_t count = mEntryCount.load(std::memory_order_relaxed);
+    std::vector<bool> seen(count, false);
+    bool atlasSeen = false;
+    for (TextureHandle handle : handles)
+    {
+        if (!handle.IsValid() || handle.id >= count || seen[handle.id] || !At(handle.id).loaded)
+            continue;
+        seen[handle.id] = true;
+        const Entry &entry = At(handle.id);
+        if (entry.inAtlas)
+        {
+            if (!atlasSeen)
+            {
+                atlasSeen = true;
+                stats.count++;
+                stats.bytes += static_cast<size_t>(mAtlasWidth) * mAtlasHeight * 4;
+            }
+            continue;
+        }
+        stats.count++;
+        stats.bytes += static_cast<size_t>(entry.width) * entry.height * 4;
+    }
+    return stats;
+}
+
+/**
+ * @brief Destroys every cached texture, including the atlas.
+ *
+ * Interned ids stay valid; the next LoadTexture() reloads from disk.
+ * Must be called before the renderer that created the textures is destroyed.
+ */
+void ResourceManager::Clear()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    ReleaseAtlas();
+    const size_t count = mEntryCount.load(std::memory_order_relaxed);
+    for (size_t id = 0; id < count; ++id)
+    {
+        Entry &entry = At(static_cast<AssetId>(id));
+        if (entry.texture)
+            SDL_DestroyTexture(entry.texture);
+        if (entry.pixels)
+            SDL_FreeSurface(entry.pixels);
+        entry.pixels = nullptr;
+        entry.texture = nullptr;
+        entry.renderer = nullptr;
+        entry.loaded = false;
+    }
 }
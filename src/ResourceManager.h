@@ -2,16 +2,71 @@
 #define RESOURCE_MANAGER_H
 
 #include <unordered_map>
+#include <vector>
 #include <memory>
+#include <mutex>
+#include <atomic>
 #include <string>
+#include <cstdint>
+#include <cstddef>
 #include <SDL2/SDL.h>
 
+/**
+ * @brief Interned asset path. Comparing or storing an AssetId never touches the path string.
+ */
+using AssetId = uint16_t;
+
+/**
+ * @brief Marks an AssetId or TextureHandle that refers to nothing.
+ */
+constexpr AssetId kInvalidAsset = UINT16_MAX;
+
+/**
+ * @brief Lightweight reference to a cached texture, cheap to copy and store per entity.
+ */
+struct TextureHandle
+{
+    AssetId id = kInvalidAsset;
+
+    bool IsValid() const { return id != kInvalidAsset; }
+    bool operator==(const TextureHandle &other) const { return id == other.id; }
+    bool operator!=(const TextureHandle &other) const { return id != other.id; }
+};
+
+/**
+ * @brief Number of distinct textures and their estimated GPU memory.
+ */
+struct TextureStats
+{
+    size_t count = 0;
+    size_t bytes = 0;
+};
+
+const std::vector<std::string> &SpriteAssetPaths();
+
 /**
  * @brief The ResourceManager class manages game resources, such as textures.
  *
- * This singleton class loads BMP textures via SDL and caches them to avoid
- * duplicate loading. It returns shared pointers to SDL_Texture objects that are
- * automatically freed when no longer needed.
+ * This singleton is the single texture cache of the game. Asset paths are interned once
+ * into AssetIds; each BMP is read from disk and uploaded at most once per renderer, and
+ * entities keep a TextureHandle rather than their own SDL_Texture. With a null renderer
+ * (headless mode) only the image size is cached.
+ *
+ * BuildAtlas() packs a set of images into one shared atlas texture. Atlased handles then
+ * return the atlas from GetTexture() and their sub-rectangle from GetSourceRect()/GetUV(),
+ * so sprites of different kinds can be drawn in the same batch. Handles that are not in
+ * the atlas report their whole texture as the source.
+ *
+ * Textures are owned by the cache and destroyed by Clear(), which must run before the
+ * renderer is destroyed.
+ *
+ * Scenes may be loaded on a worker thread (see SceneStreamer). Intern(), LoadTexture() with a
+ * null renderer, GetWidth(), GetHeight(), GetPath() and GetStats() are safe to call from any
+ * thread: entries never move once interned, and an image's size never changes once it has
+ * been decoded. A headless load decodes the BMP and keeps the pixels, so the GPU upload that
+ * a later LoadTexture() with a renderer does on the render thread needs no disk access.
+ * Anything touching SDL textures (LoadTexture() with a renderer, BuildAtlas(), Clear()) and
+ * the texture, source rectangle and UV getters belong to the render thread.
  */
 class ResourceManager
 {
@@ -29,7 +84,62 @@ public:
         return instance;
     }
 
-    std::shared_ptr<SDL_Texture> LoadTexture(const std::string &filePath, SDL_Renderer *renderer);
+    AssetId Intern(const std::string &filePath);
+    TextureHandle LoadTexture(AssetId id, SDL_Renderer *renderer);
+    TextureHandle LoadTexture(const std::string &filePath, SDL_Renderer *renderer);
+
+    /**
+     * @brief Returns the SDL_Texture behind a handle.
+     *
+     * @param handle A handle returned by LoadTexture().
+     * @return SDL_Texture* The texture, or nullptr when headless or the load failed.
+     */
+    SDL_Texture *GetTexture(TextureHandle handle) const { return handle.IsValid() ? At(handle.id).texture : nullptr; }
+
+    /**
+     * @brief Returns the pixel width of a cached image.
+     *
+     * @param handle A handle returned by LoadTexture().
+     * @return int The width, or 0 if the load failed.
+     */
+    int GetWidth(TextureHandle handle) const { return handle.IsValid() ? At(handle.id).width : 0; }
+
+    /**
+     * @brief Returns the pixel height of a cached image.
+     *
+     * @param handle A handle returned by LoadTexture().
+     * @return int The height, or 0 if the load failed.
+     */
+    int GetHeight(TextureHandle handle) const { return handle.IsValid() ? At(handle.id).height : 0; }
+
+    /**
+     * @brief Returns the region of GetTexture() that holds an image, in pixels.
+     *
+     * @param handle A handle returned by LoadTexture().
+     * @return SDL_Rect The image's rectangle in the atlas, or the whole texture if not atlased.
+     */
+    SDL_Rect GetSourceRect(TextureHandle handle) const
+    {
+        if (!handle.IsValid())
+            return SDL_Rect{0, 0, 0, 0};
+        const Entry &entry = At(handle.id);
+        return entry.inAtlas ? entry.atlasRect : SDL_Rect{0, 0, entry.width, entry.height};
+    }
+
+    /**
+     * @brief Returns the region of GetTexture() that holds an image, in normalized coordinates.
+     *
+     * @param handle A handle returned by LoadTexture().
+     * @return SDL_FRect The image's UV rectangle (x, y, width, height).
+     */
+    SDL_FRect GetUV(TextureHandle handle) const { return handle.IsValid() ? At(handle.id).uv : SDL_FRect{0, 0, 1, 1}; }
+
+    bool BuildAtlas(const std::vector<std::string> &filePaths, SDL_Renderer *renderer);
+    bool ReloadTexture(const std::string &filePath, SDL_Surface *pixels);
+    const std::string &GetPath(AssetId id) const;
+    TextureStats GetStats() const;
+    TextureStats GetStats(const std::vector<TextureHandle> &handles) const;
+    void Clear();
 
 private:
     ResourceManager() = default;
@@ -37,7 +147,41 @@ private:
     ResourceManager(const ResourceManager &) = delete;
     ResourceManager &operator=(const ResourceManager &) = delete;
 
-    std::unordered_map<std::string, std::shared_ptr<SDL_Texture>> textures;
+    struct Entry
+    {
+        std::string path;
+        SDL_Texture *texture = nullptr;
+        SDL_Surface *pixels = nullptr; // decoded by a headless load, awaiting upload
+        SDL_Renderer *renderer = nullptr;
+        int width = 0;
+        int height = 0;
+        bool loaded = false;
+        bool inAtlas = false;
+        SDL_Rect atlasRect{0, 0, 0, 0};
+        SDL_FRect uv{0, 0, 1, 1};
+    };
+
+    // Entries live in fixed-size chunks that are never reallocated, so a reference to one
+    // stays valid while other threads intern new paths.
+    static constexpr size_t kChunkSize = 256;
+    static constexpr size_t kChunkCount = (size_t(kInvalidAsset) + kChunkSize - 1) / kChunkSize;
+
+    /**
+     * @brief Returns the entry of an interned id.
+     */
+    Entry &At(AssetId id) { return mChunks[id / kChunkSize][id % kChunkSize]; }
+    const Entry &At(AssetId id) const { return mChunks[id / kChunkSize][id % kChunkSize]; }
+
+    void ReleaseAtlas();
+    void SetSize(Entry &entry, int width, int height);
+
+    mutable std::mutex mMutex;
+    std::unordered_map<std::string, AssetId> mIds;
+    std::unique_ptr<Entry[]> mChunks[kChunkCount];
+    std::atomic<size_t> mEntryCount{0};
+    SDL_Texture *mAtlasTexture = nullptr;
+    int mAtlasWidth = 0;
+    int mAtlasHeight = 0;
 };
 
 #endif
@@ -1,9 +1,12 @@
 #include "Scene.h"
-#include <fstream>
-#include <sstream>
 #include <iostream>
 #include <SDL2/SDL.h>
 #include "InputComponent.h"
+#include "Profiler.h"
+#include "SweptAABB.h"
+#include "SceneFile.h"
+#include "MappedFile.h"
+#include <algorithm>
 #include <cstdlib>
 #include <cmath>
 
@@ -12,403 +15,1075 @@
  *
  * Initializes the scene state.
  */
-Scene::Scene() : mRenderer(nullptr), mSceneIsActive(true)
+Scene::Scene() : mRenderer(nullptr), mSceneIsActive(true), mGameOver(false)
 {
 }
 
 /**
  * @brief Loads scene data from a file.
  *
- * Reads each line of the scene file to create and initialize game entities.
- * Supported entity types include:
+ * The file is memory-mapped. It is either a text scene, parsed in place by ParseSceneText(),
+ * or a binary scene made by --convert-scene (see SceneFileHeader), whose record arrays are
+ * used in place with no parsing at all. The records are then handed to Load().
  *  - PADDLE: Creates the player paddle. (Format: PADDLE x y)
  *  - BALL: Creates a ball. (Format: BALL x y vX vY)
  *  - BRICK: Creates a breakable brick and scales it up by 1.5 times. (Format: BRICK x y)
  *  - UNBRICK: Creates an unbreakable brick (using a different texture), scales it up, and marks it as unbreakable.
+ *  - BRICKROW, BRICKGRID, BRICKMASK and their UN forms: Create rows, grids or bitmask patterns of
+ *    bricks in one line; they expand to the same records as one line per brick (see ParseSceneText()).
+ *
+ * A file that cannot be read leaves the scene empty.
  *
  * @param sceneFile The path to the scene file.
  * @param renderer The SDL_Renderer used for creating textures and rendering.
  */
 void Scene::LoadFromFile(const std::string &sceneFile, SDL_Renderer *renderer)
 {
+    MappedFile mapped;
+    SceneData parsed;
+    SceneView records;
+    bool loaded = false;
+    if (!mapped.Open(sceneFile))
+    {
+        std::cerr << "Can't open the file: " << sceneFile << std::endl;
+    }
+    else if (IsSceneBinary(mapped.Data(), mapped.Size()))
+    {
+        std::cout << "Loading binary scene from file: " << sceneFile << std::endl;
+        loaded = ReadSceneBinary(mapped.Data(), mapped.Size(), records);
+        if (!loaded)
+            std::cerr << "Can't load the file: " << sceneFile << std::endl;
+    }
+    else
+    {
+        std::cout << "Loading scene from file: " << sceneFile << std::endl;
+        std::vector<SceneDiagnostic> diagnostics;
+        ParseSceneText(mapped.Data(), mapped.Size(), parsed, diagnostics);
+        ReportSceneDiagnostics(sceneFile, diagnostics);
+        records = ViewScene(parsed);
+        loaded = true;
+    }
+    Load(loaded ? records : SceneView(), renderer);
+    if (!loaded)
+        return;
+
+    TextureStats textures = GetTextureStats();
+    std::cout << "Loaded scene: Paddle: " << (mPlayerPaddle ? "yes" : "no")
+              << ", Balls count: " << mBalls.size()
+              << ", Bricks count: " << GetBrickCount()
+              << ", Textures: " << textures.count << " (" << textures.bytes << " bytes)" << std::endl;
+}
 
+/**
+ * @brief Replaces the scene's contents with entities built from parsed records.
+ *
+ * Lets a caller that plays the same level many times (see BatchRunner) parse it once and
+ * rebuild scenes from the records, without touching the disk or printing anything.
+ * Entities are created in bulk: paddles, then balls, then bricks in record order.
+ *
+ * @param records The paddle, ball and brick records; they are only read during the call.
+ * @param renderer The SDL_Renderer used for creating textures and rendering, or nullptr when headless.
+ */
+void Scene::Load(const SceneView &records, SDL_Renderer *renderer)
+{
     mRenderer = renderer;
+    mSceneIsActive = true;
+    mGameOver = false;
+    mBallsLost = 0;
+    mBricksBroken = 0;
+    mDropsCaught = 0;
+    mScore = 0;
 
     mPlayerPaddle.reset();
-    mBalls.clear();
+    while (!mBalls.empty())
+        RemoveBall(mBalls.size() - 1);
+    while (!mDrops.empty())
+        RemoveDrop(mDrops.size() - 1);
     mBricks.clear();
-    mDrops.clear();
+    mLegacyBricksLeft = 0;
+    mBrickField.Clear();
+    mEntities.Clear();
+
+    // Every texture the scene can need, including mid-frame spawns, comes from the shared
+    // cache up front so no entity ever touches the disk.
+    ResourceManager &resources = ResourceManager::getInstance();
+    mPaddleTexture = resources.LoadTexture("../Assets/paddle.bmp", renderer);
+    mBallTexture = resources.LoadTexture("../Assets/ball.bmp", renderer);
+    mBrickTexture = resources.LoadTexture("../Assets/brick.bmp", renderer);
+    mUnbrickTexture = resources.LoadTexture("../Assets/unbrick.bmp", renderer);
+    mDropTexture = resources.LoadTexture("../Assets/drop.bmp", renderer);
+
+    CreateEntities(records);
+
+    mBrickStorage.SyncCollision();
+    mBrickGrid.Build(mBricks);
+    mBrickLayer.Invalidate();
+}
 
-    std::ifstream infile(sceneFile);
-    if (!infile.is_open())
+/**
+ * @brief Uploads the scene's textures to a renderer, for a scene loaded without one.
+ *
+ * A scene loaded headless on a worker thread (see SceneStreamer) has its images decoded
+ * but not uploaded; call this on the render thread before rendering it. Textures already
+ * on the renderer, such as the atlas, are not touched.
+ *
+ * @param renderer The SDL_Renderer the scene will be drawn with.
+ */
+void Scene::AttachRenderer(SDL_Renderer *renderer)
+{
+    mRenderer = renderer;
+    mBrickLayer.Invalidate();
+    ResourceManager &resources = ResourceManager::getInstance();
+    for (TextureHandle texture : {mPaddleTexture, mBallTexture, mBrickTexture, mUnbrickTexture, mDropTexture})
     {
-        std::cerr << "Can't open the file: " << sceneFile << std::endl;
-        return;
+        if (texture.IsValid())
+            resources.LoadTexture(texture.id, renderer);
+    }
+}
+
+/**
+ * @brief Creates the entities described by a scene's records.
+ *
+ * Bricks go into the BrickField, sized like a brick entity (the brick image scaled up by
+ * 1.5 times); only the bricks it cannot hold (off its lattice, on a cell already taken, or
+ * unbreakable bricks whose image differs in size) become Brick entities, in record order.
+ * Storage for all of them is reserved up front so large levels do not regrow the arrays.
+ *
+ * @param records The paddle, ball and brick records.
+ */
+void Scene::CreateEntities(const SceneView &records)
+{
+    const ResourceManager &resources = ResourceManager::getInstance();
+    const int brickW = resources.GetWidth(mBrickTexture), brickH = resources.GetHeight(mBrickTexture);
+    const bool unbreakableFits = resources.GetWidth(mUnbrickTexture) == brickW && resources.GetHeight(mUnbrickTexture) == brickH;
+    std::vector<uint32_t> legacy;
+    mBrickField.SetTextures(mBrickTexture, mUnbrickTexture);
+    if (mUseBrickField)
+    {
+        mBrickField.Build(records.bricks, records.brickCount, static_cast<float>(brickW) * 1.5f, static_cast<float>(brickH) * 1.5f,
+                          unbreakableFits, legacy);
+    }
+    else
+    {
+        for (size_t i = 0; i < records.brickCount; ++i)
+            legacy.push_back(static_cast<uint32_t>(i));
     }
 
-    std::cout << "Loading scene from file: " << sceneFile << std::endl;
+    const size_t total = records.paddleCount + records.ballCount + legacy.size();
+    mEntities.Reserve(total);
+    mPaddleStorage.Reserve(records.paddleCount);
+    mBallStorage.Reserve(records.ballCount);
+    mBrickStorage.Reserve(legacy.size());
+    mBalls.reserve(records.ballCount);
+    mBricks.reserve(legacy.size());
 
-    std::string line;
-    while (std::getline(infile, line))
+    for (size_t i = 0; i < records.paddleCount; ++i)
     {
-        if (line.empty() || line[0] == '#')
-            continue;
+        mPlayerPaddle = std::make_shared<Paddle>(mRenderer, "../Assets/paddle.bmp", 500.0f);
+        mPlayerPaddle->initComponents(mPaddleTexture, &mPaddleStorage);
 
-        std::istringstream iss(line);
-        std::string entityType;
-        iss >> entityType;
-        if (entityType == "PADDLE")
-        {
-            float x, y;
-            if (!(iss >> x >> y))
-            {
-                std::cerr << "Error reading PADDLE data: " << line << std::endl;
-                continue;
-            }
-            mPlayerPaddle = std::make_shared<Paddle>(renderer, "../Assets/paddle.bmp", 500.0f);
-            mPlayerPaddle->initComponents(renderer, "../Assets/paddle.bmp");
+        std::shared_ptr<InputComponent> inputComp = std::make_shared<InputComponent>();
+        inputComp->mSpeed = 300.0f;
+        mPlayerPaddle->AddComponent<InputComponent>(inputComp);
 
-            std::shared_ptr<InputComponent> inputComp = std::make_shared<InputComponent>();
-            inputComp->mSpeed = 300.0f;
-            mPlayerPaddle->AddComponent<InputComponent>(inputComp);
+        mPlayerPaddle->SetHandle(mEntities.Create(mPlayerPaddle.get()));
 
-            auto paddleTrans = mPlayerPaddle->GetTransform();
+        auto paddleTrans = mPlayerPaddle->GetTransform();
 
-            if (paddleTrans)
-                paddleTrans->move(x, y);
-        }
-        else if (entityType == "BALL")
-        {
-            float x, y, vX, vY;
-            if (!(iss >> x >> y >> vX >> vY))
-            {
-                std::cerr << "Error reading BALL data: " << line << std::endl;
-                continue;
-            }
-            std::shared_ptr<Ball> ball = std::make_shared<Ball>(renderer, "../Assets/ball.bmp", 250.0f);
-            ball->initComponents(renderer, "../Assets/ball.bmp");
-            auto ballTrans = ball->GetTransform();
-            if (ballTrans)
-                ballTrans->move(x, y);
-            ball->SetVelocity(vX, vY);
-            mBalls.push_back(ball);
-        }
-        else if (entityType == "BRICK")
-        {
-            float x, y;
-            if (!(iss >> x >> y))
-            {
-                std::cerr << "Error reading BRICK data: " << line << std::endl;
-                continue;
-            }
-            std::shared_ptr<Brick> brick = std::make_shared<Brick>(renderer, "../Assets/brick.bmp");
-            brick->initComponents(renderer, "../Assets/brick.bmp");
-            auto brickTrans = brick->GetTransform();
-            if (brickTrans)
-            {
-                brickTrans->move(x, y);
+        if (paddleTrans)
+            paddleTrans->place(records.paddles[i].x, records.paddles[i].y);
+    }
 
-                float currentW = brickTrans->getW();
-                float currentH = brickTrans->getH();
+    for (size_t i = 0; i < records.ballCount; ++i)
+    {
+        const SceneBallRecord &ball = records.balls[i];
+        SpawnBall(ball.x, ball.y, ball.velX, ball.velY);
+    }
 
-                brickTrans->setW(currentW * 1.5f);
-                brickTrans->setH(currentH * 1.5f);
-            }
-            mBricks.push_back(brick);
+    for (uint32_t i : legacy)
+        CreateBrick(records.bricks[i]);
+}
+
+/**
+ * @brief Creates one brick, scaled up by 1.5 times, at the end of mBricks.
+ *
+ * @param record The brick's position and kind.
+ */
+void Scene::CreateBrick(const SceneBrickRecord &record)
+{
+    std::shared_ptr<Brick> brick = std::make_shared<Brick>(mRenderer, record.unbreakable ? "../Assets/unbrick.bmp" : "../Assets/brick.bmp");
+    brick->initComponents(record.unbreakable ? mUnbrickTexture : mBrickTexture, &mBrickStorage);
+    brick->SetUnbreakable(record.unbreakable != 0);
+    auto brickTrans = brick->GetTransform();
+    if (brickTrans)
+    {
+        brickTrans->place(record.x, record.y);
+
+        float currentW = brickTrans->getW();
+        float currentH = brickTrans->getH();
+
+        brickTrans->setW(currentW * 1.5f);
+        brickTrans->setH(currentH * 1.5f);
+    }
+    brick->SetHandle(mEntities.Create(brick.get()));
+    mBricks.push_back(brick);
+    if (!record.unbreakable)
+        ++mLegacyBricksLeft;
+}
+
+/**
+ * @brief Brings the bricks in line with a new version of the scene's file, keeping everything else.
+ *
+ * Used by hot reload. Bricks are matched to records by position and kind: matched bricks
+ * are left alone (a brick broken in play stays broken), bricks with no record are removed
+ * and records with no brick get a new brick. The paddle, balls, drops and counters are not
+ * touched, and neither are paddle or ball records. New bricks go into a free BrickField cell
+ * when they are on its lattice and become Brick entities otherwise. Removed Brick entities
+ * are swapped with the last one, so brick indices (and WriteBrickMask() bits) are renumbered;
+ * the broadphase is rebuilt and only the static layer regions of removed and added bricks
+ * are redrawn.
+ *
+ * @param records The scene file's records.
+ * @param added Receives the number of bricks created.
+ * @param removed Receives the number of bricks removed.
+ */
+void Scene::ApplyBrickEdits(const SceneView &records, size_t &added, size_t &removed)
+{
+    struct Key
+    {
+        float x, y;
+        uint8_t unbreakable;
+        uint32_t index; // brick id for live bricks, record index for wanted ones
+
+        bool operator<(const Key &other) const
+        {
+            if (x != other.x)
+                return x < other.x;
+            if (y != other.y)
+                return y < other.y;
+            return unbreakable < other.unbreakable;
         }
-        else if (entityType == "UNBRICK")
+    };
+
+    std::vector<Key> live, wanted;
+    live.reserve(GetBrickCount());
+    for (uint32_t cell = 0; cell < mBrickField.GetCellCount(); ++cell)
+    {
+        if (mBrickField.IsPresent(cell))
         {
-            float x, y;
-            if (!(iss >> x >> y))
-            {
-                std::cerr << "Error reading UNBRICK data: " << line << std::endl;
-                continue;
-            }
-            std::shared_ptr<Brick> brick = std::make_shared<Brick>(renderer, "../Assets/unbrick.bmp");
-            brick->initComponents(renderer, "../Assets/unbrick.bmp");
-            brick->SetUnbreakable(true);
-            auto brickTrans = brick->GetTransform();
-            if (brickTrans)
-            {
-                brickTrans->move(x, y);
+            const SDL_FRect rect = mBrickField.GetRect(cell);
+            live.push_back(Key{rect.x, rect.y, static_cast<uint8_t>(mBrickField.IsUnbreakable(cell)), cell});
+        }
+    }
+    for (size_t i = 0; i < mBricks.size(); ++i)
+        live.push_back(Key{mBrickStorage.mX[i], mBrickStorage.mY[i], static_cast<uint8_t>(mBricks[i]->IsUnbreakable()), static_cast<uint32_t>(i) | kLegacyBrick});
+    wanted.reserve(records.brickCount);
+    for (size_t i = 0; i < records.brickCount; ++i)
+        wanted.push_back(Key{records.bricks[i].x, records.bricks[i].y, static_cast<uint8_t>(records.bricks[i].unbreakable != 0), static_cast<uint32_t>(i)});
+    std::sort(live.begin(), live.end());
+    std::sort(wanted.begin(), wanted.end());
 
-                float currentW = brickTrans->getW();
-                float currentH = brickTrans->getH();
+    std::vector<uint32_t> stale;
+    std::vector<uint32_t> fresh;
+    size_t l = 0, w = 0;
+    while (l < live.size() || w < wanted.size())
+    {
+        if (w == wanted.size() || (l < live.size() && live[l] < wanted[w]))
+            stale.push_back(live[l++].index);
+        else if (l == live.size() || wanted[w] < live[l])
+            fresh.push_back(wanted[w++].index);
+        else
+            ++l, ++w;
+    }
+    added = fresh.size();
+    removed = stale.size();
+    if (stale.empty() && fresh.empty())
+        return;
 
-                brickTrans->setW(currentW * 1.5f);
-                brickTrans->setH(currentH * 1.5f);
-            }
-            mBricks.push_back(brick);
+    // Highest index first, so the brick swapped into a removed slot is always one to keep.
+    std::sort(stale.begin(), stale.end(), [](uint32_t a, uint32_t b)
+              { return a > b; });
+    for (uint32_t id : stale)
+    {
+        mBrickLayer.MarkDirty(GetBrickRect(id));
+        if (!(id & kLegacyBrick))
+        {
+            mBrickField.Remove(id);
+            continue;
         }
-        else
+        const uint32_t index = id & ~kLegacyBrick;
+        std::shared_ptr<Brick> brick = std::move(mBricks[index]);
+        if (brick->IsActive() && !brick->IsUnbreakable())
+            --mLegacyBricksLeft;
+        mEntities.Destroy(brick->GetHandle());
+        brick->ReleaseStorage();
+        if (index != mBricks.size() - 1)
+            mBricks[index] = std::move(mBricks.back());
+        mBricks.pop_back();
+    }
+
+    std::sort(fresh.begin(), fresh.end());
+    for (uint32_t record : fresh)
+    {
+        const SceneBrickRecord &brick = records.bricks[record];
+        uint32_t cell;
+        if (mBrickField.Place(brick.x, brick.y, brick.unbreakable != 0, cell))
         {
-            std::cerr << "Unknown entity type: " << entityType << std::endl;
+            mBrickLayer.MarkDirty(mBrickField.GetRect(cell));
+            continue;
         }
+        CreateBrick(brick);
+        mBrickLayer.MarkDirty(mBrickStorage.GetRect(mBricks.size() - 1));
     }
-    infile.close();
 
-    std::cout << "Loaded scene: Paddle: " << (mPlayerPaddle ? "yes" : "no")
-              << ", Balls count: " << mBalls.size()
-              << ", Bricks count: " << mBricks.size() << std::endl;
+    mBrickStorage.SyncCollision();
+    mBrickGrid.Build(mBricks);
+}
+
+/**
+ * @brief Records the current positions as the starting point of the next simulation step.
+ *
+ * Call it before each fixed step; Render() interpolates between the recorded and the
+ * stepped positions. Headless runs that never render can skip it.
+ */
+void Scene::SaveRenderState()
+{
+    mPaddleStorage.SavePrevious();
+    mBallStorage.SavePrevious();
+    mBrickStorage.SavePrevious();
+    mDropStorage.SavePrevious();
 }
 
 /**
  * @brief Processes input for the scene.
  *
- * Delegates input processing to the player paddle.
+ * Hands the buttons held this step to the player paddle's InputComponent and delegates input
+ * processing to the paddle. The buttons come from the caller (the keyboard, a replayed input
+ * log or a scripted controller), so a step's outcome depends only on them and the scene state.
  *
  * @param deltaTime The time elapsed since the last frame in seconds.
+ * @param buttons The InputButton bits held during this step.
  */
-void Scene::Input(float deltaTime)
+void Scene::Input(float deltaTime, uint8_t buttons)
 {
-    if (mPlayerPaddle)
-        mPlayerPaddle->Input(deltaTime);
+    if (!mPlayerPaddle)
+        return;
+    auto input = mPlayerPaddle->GetComponent<InputComponent>();
+    if (input)
+        input->SetButtons(buttons);
+    mPlayerPaddle->Input(deltaTime);
 }
 
 /**
  * @brief Updates the scene state.
  *
- * This method updates the player paddle, drops, and balls; processes collisions between drops and the paddle,
- * bricks and balls, and between balls and the paddle; and removes balls that exit the bottom of the screen.
- * If no ball remains, the game is over and the program will exit.
+ * This method updates the player paddle and drops (the latter as a linear sweep over their
+ * ArchetypeStorage arrays), removing drops that fell past the bottom of the screen; catches
+ * drops that touch the paddle, testing all of them at once with OverlapBatch(); moves the
+ * balls with continuous collision against walls, bricks and the paddle (see MoveBalls()); and
+ * removes balls that exit the bottom of the screen. Removed balls and drops go back to their
+ * EntityPool, so none of this allocates once the pools are warm.
+ * If no ball remains, the game is over: the scene is ended and IsGameOver() reports true so the
+ * caller (the windowed Application or the headless driver) can decide what to do.
+ * If no breakable brick remains (a running count, see GetBricksLeft()), the level is cleared:
+ * the balls are removed and the scene is ended.
  *
  * @param deltaTime The time elapsed since the last frame in seconds.
  */
 void Scene::Update(float deltaTime)
 {
+    PROFILE_ZONE("Scene::Update");
 
     if (mPlayerPaddle)
         mPlayerPaddle->Update(deltaTime);
 
-    for (auto &drop : mDrops)
     {
-        drop->Update(deltaTime);
+        PROFILE_ZONE("Drops");
+        mDropStorage.Integrate(deltaTime);
+        for (size_t row = mDropStorage.Size(); row-- > 0;)
+        {
+            if (mDropStorage.mY[row] > kOffScreenY)
+                RemoveDrop(row);
+        }
+        mDropStorage.SyncCollision();
     }
 
     if (mPlayerPaddle)
     {
-        auto paddleColl = mPlayerPaddle->GetComponent<Collision2DComponent>(ComponentType::Collision2DComponent);
+        PROFILE_ZONE("DropPickup");
+        auto paddleColl = mPlayerPaddle->GetComponent<Collision2DComponent>();
         if (paddleColl)
         {
             SDL_FRect paddleRect = paddleColl->getRectangle();
-            for (auto it = mDrops.begin(); it != mDrops.end();)
+            const size_t dropCount = mDropStorage.Size();
+            mDropBounds.Assign(mDropStorage.mX.data(), mDropStorage.mY.data(), mDropStorage.mW.data(), mDropStorage.mH.data(), dropCount);
+            mDropOverlaps.resize(dropCount);
+            const size_t caught = OverlapBatch(paddleRect, mDropBounds, mDropOverlaps.data());
+
+            // mDrops[i] owns drop row i and removal swaps the last row in, so catching from
+            // the highest row down leaves the rows still to catch in place.
+            for (size_t i = caught; i-- > 0;)
             {
-                auto dropTrans = (*it)->GetTransform();
-                if (dropTrans)
+                const size_t currentBallCount = mBalls.size();
+                for (size_t ball = 0; ball < currentBallCount; ++ball)
                 {
-                    SDL_FRect dropRect = dropTrans->getRectangle();
-                    if (SDL_HasIntersectionF(&paddleRect, &dropRect))
-                    {
-                        size_t currentBallCount = mBalls.size();
-                        for (size_t i = 0; i < currentBallCount; ++i)
-                        {
-                            std::shared_ptr<Ball> newBall = std::make_shared<Ball>(mRenderer, "../Assets/ball.bmp", 250.0f);
-                            newBall->initComponents(mRenderer, "../Assets/ball.bmp");
-                            auto origBallTrans = mBalls[i]->GetTransform();
-                            if (origBallTrans)
-                            {
-                                SDL_FRect origRect = origBallTrans->getRectangle();
-                                newBall->GetTransform()->move(origRect.x + 20, origRect.y);
-                            }
-
-                            newBall->SetVelocity(100.0, 100.0);
-                            mBalls.push_back(newBall);
-                        }
-                        it = mDrops.erase(it);
-                        continue;
-                    }
+                    const float x = mBallStorage.mX[ball];
+                    const float y = mBallStorage.mY[ball];
+                    SpawnBall(x + 20, y, 100.0f, 100.0f);
                 }
-                ++it;
+                RemoveDrop(mDropOverlaps[i]);
+                ++mDropsCaught;
+                mScore += kDropPoints;
             }
         }
     }
 
-    for (auto &ball : mBalls)
+    MoveBalls(deltaTime);
+
+    PROFILE_ZONE("Cleanup");
+    for (size_t row = mBallStorage.Size(); row-- > 0;)
     {
-        ball->Update(deltaTime);
+        if (mBallStorage.mY[row] > kOffScreenY)
+        {
+            RemoveBall(row);
+            ++mBallsLost;
+        }
     }
 
-    for (auto &ball : mBalls)
+    if (mBalls.empty())
     {
-        auto ballTrans = ball->GetTransform();
-        if (!ballTrans)
-            continue;
-        SDL_FRect ballRect = ballTrans->getRectangle();
+        mGameOver = true;
+        SetSceneStatus(false);
+        return;
+    }
 
-        for (auto &brick : mBricks)
-        {
-            if (!brick->IsActive())
-                continue;
-            auto brickTrans = brick->GetTransform();
-            if (!brickTrans)
-                continue;
-            SDL_FRect brickRect = brickTrans->getRectangle();
-            if (SDL_HasIntersectionF(&ballRect, &brickRect))
-            {
-                if (!brick->IsUnbreakable())
-                {
-                    brick->SetActive(false);
-                    // 30%
-                    if ((rand() % 100) < 30)
-                    {
-
-                        std::shared_ptr<Drop> drop = std::make_shared<Drop>(mRenderer, "../Assets/drop.bmp", 200.0f);
-                        drop->initComponents(mRenderer, "../Assets/drop.bmp");
-
-                        if (brickTrans)
-                            drop->GetTransform()->move(brickTrans->getX(), brickTrans->getY());
-                        mDrops.push_back(drop);
-                    }
-                }
+    if (GetBricksLeft() == 0)
+    {
+        while (!mBalls.empty())
+            RemoveBall(mBalls.size() - 1);
+        SetSceneStatus(false);
+    }
+}
 
-                float ballRight = ballRect.x + ballRect.w;
-                float brickRight = brickRect.x + brickRect.w;
-                float ballBottom = ballRect.y + ballRect.h;
-                float brickBottom = brickRect.y + brickRect.h;
+/**
+ * @brief Moves every ball through one step with continuous collision detection.
+ *
+ * Each ball is swept against the walls, the bricks near its path and the paddle (see
+ * SweepBall()), bouncing at the exact time of impact as often as needed within the step,
+ * so it cannot tunnel through anything however fast it moves or however long the step is.
+ *
+ * The sweeps run in parallel on the job system against the bricks alive at the start of
+ * the pass and write only their own BallSweep. The results are then committed serially in
+ * ball order, so breaking bricks, spawning drops and drawing random numbers happen in the
+ * same order for any thread count:
+ *  - a ball that hit a brick already broken by an earlier ball in this pass is swept again
+ *    against the current bricks, exactly as a serial loop would have seen them;
+ *  - a sweep stops when it lands on the paddle's top face, because the deflection may draw a
+ *    random number; the deflection is applied here and the sweep continues.
+ *
+ * @param deltaTime The time step in seconds.
+ */
+void Scene::MoveBalls(float deltaTime)
+{
+    PROFILE_ZONE("MoveBalls");
+    const size_t ballCount = mBallStorage.Size();
 
-                float overlapX = std::min(ballRight, brickRight) - std::max(ballRect.x, brickRect.x);
-                float overlapY = std::min(ballBottom, brickBottom) - std::max(ballRect.y, brickRect.y);
+    mBallSweeps.resize(ballCount);
+    auto sweepRange = [this, deltaTime](size_t begin, size_t end)
+    {
+        thread_local std::vector<uint32_t> candidates;
+        for (size_t ballRow = begin; ballRow < end; ++ballRow)
+        {
+            StartSweep(ballRow, mBallSweeps[ballRow]);
+            SweepBall(mBallSweeps[ballRow], deltaTime, candidates);
+        }
+    };
+    if (mJobs)
+        mJobs->ParallelFor(ballCount, kBallsPerJob, sweepRange);
+    else
+        sweepRange(0, ballCount);
 
-                if (overlapX < overlapY)
-                {
-                    if (ballRect.x < brickRect.x)
-                    {
-                        ball->GetTransform()->move(brickRect.x - ballRect.w - 1, ballRect.y);
-                    }
-                    else
-                    {
-                        ball->GetTransform()->move(brickRect.x + brickRect.w + 1, ballRect.y);
-                    }
-                    ball->ReverseVelX();
-                }
-                else
-                {
-                    if (ballRect.y < brickRect.y)
-                    {
-                        ball->GetTransform()->move(ballRect.x, brickRect.y - ballRect.h - 1);
-                    }
-                    else
-                    {
-                        ball->GetTransform()->move(ballRect.x, brickRect.y + brickRect.h + 1);
-                    }
-                    ball->ReverseVelY();
-                }
+    for (size_t ballRow = 0; ballRow < ballCount; ++ballRow)
+    {
+        BallSweep &sweep = mBallSweeps[ballRow];
+        for (uint8_t i = 0; i < sweep.hitCount; ++i)
+        {
+            if (!IsBrickAlive(sweep.hits[i]))
+            {
+                StartSweep(ballRow, sweep);
+                SweepBall(sweep, deltaTime, mBrickCandidates);
                 break;
             }
         }
+
+        for (;;)
+        {
+            for (uint8_t i = 0; i < sweep.hitCount; ++i)
+                BreakBrick(sweep.hits[i]);
+            sweep.hitCount = 0;
+            if (!sweep.paddlePending)
+                break;
+            sweep.paddlePending = false;
+            DeflectOffPaddle(sweep.velX, sweep.velY);
+            SweepBall(sweep, deltaTime, mBrickCandidates);
+        }
+
+        mCollisionCount += sweep.bounces;
+        mBallStorage.mX[ballRow] = sweep.x;
+        mBallStorage.mY[ballRow] = sweep.y;
+        mBallStorage.mVelX[ballRow] = sweep.velX;
+        mBallStorage.mVelY[ballRow] = sweep.velY;
     }
+    mBallStorage.SyncCollision();
+}
 
-    for (auto &ball : mBalls)
+/**
+ * @brief Loads a ball's row into a fresh sweep covering the whole step.
+ *
+ * @param ballRow The ball's row in the ball storage.
+ * @param sweep The sweep to initialize.
+ */
+void Scene::StartSweep(size_t ballRow, BallSweep &sweep) const
+{
+    sweep.x = mBallStorage.mX[ballRow];
+    sweep.y = mBallStorage.mY[ballRow];
+    sweep.w = mBallStorage.mW[ballRow];
+    sweep.h = mBallStorage.mH[ballRow];
+    sweep.velX = mBallStorage.mVelX[ballRow];
+    sweep.velY = mBallStorage.mVelY[ballRow];
+    sweep.remaining = 1.0f;
+    sweep.bounces = 0;
+    sweep.hitCount = 0;
+    sweep.paddlePending = false;
+}
+
+/**
+ * @brief Advances a ball through the rest of its step, bouncing off whatever it meets first.
+ *
+ * Each iteration sweeps the ball's box over its remaining displacement against the left,
+ * top and right walls, the unbroken bricks the path crosses (BrickField cells, then Brick
+ * entities from the grid) and the paddle,
+ * moves it to the earliest contact (stopping a small skin short so it never rests inside),
+ * and reflects its velocity off the face hit. Breakable bricks hit are recorded in the sweep
+ * rather than broken, and bricks the ball already hit are ignored. The sweep ends when the
+ * step is used up, after kMaxBounces bounces (dropping any remaining time), or on the
+ * paddle's top face.
+ *
+ * Only reads scene state, so it may run on several threads at once.
+ *
+ * @param ball The sweep to advance.
+ * @param deltaTime The time step in seconds.
+ * @param candidates Scratch storage for the brick queries.
+ */
+void Scene::SweepBall(BallSweep &ball, float deltaTime, std::vector<uint32_t> &candidates) const
+{
+    enum class Contact
     {
-        ball->Update(deltaTime);
-    }
+        None,
+        Wall,
+        Brick,
+        Paddle
+    };
+    // The left, top and right screen edges as thick boxes; the bottom is open.
+    static const SDL_FRect walls[] = {
+        {-10000.0f, -10000.0f, 10000.0f, 30000.0f},
+        {-10000.0f, -10000.0f, 30000.0f, 10000.0f},
+        {1600.0f, -10000.0f, 10000.0f, 30000.0f},
+    };
+    const float skin = 0.01f;
 
-    if (mPlayerPaddle)
+    SDL_FRect paddleRect{0, 0, 0, 0};
+    auto paddleColl = mPlayerPaddle ? mPlayerPaddle->GetComponent<Collision2DComponent>() : nullptr;
+    if (paddleColl)
+        paddleRect = paddleColl->getRectangle();
+
+    while (ball.remaining > 0.0f && ball.bounces < kMaxBounces && !ball.paddlePending)
     {
-        auto paddleColl = mPlayerPaddle->GetComponent<Collision2DComponent>(ComponentType::Collision2DComponent);
-        if (paddleColl)
+        const float dx = ball.velX * deltaTime * ball.remaining;
+        const float dy = ball.velY * deltaTime * ball.remaining;
+        const SDL_FRect box{ball.x, ball.y, ball.w, ball.h};
+
+        SweepHit best;
+        SweepHit hit;
+        Contact contact = Contact::None;
+        uint32_t brickHit = kNoBrick;
+
+        for (const SDL_FRect &wall : walls)
         {
-            SDL_FRect paddleRect = paddleColl->getRectangle();
-            for (auto &ball : mBalls)
+            if (SweepAABB(box, dx, dy, wall, hit) && hit.time < best.time)
             {
-                auto ballTrans = ball->GetTransform();
-                if (!ballTrans)
-                    continue;
-                SDL_FRect ballRect = ballTrans->getRectangle();
-                if (SDL_HasIntersectionF(&ballRect, &paddleRect))
-                {
-                    float newY = paddleRect.y - ballRect.h - 1;
-                    ball->GetTransform()->move(ballRect.x, newY);
-                    ball->ReverseVelY();
-
-                    float paddleVel = mPlayerPaddle->GetInstantaneousVelocity();
-                    int sign = 0;
-                    if (fabs(paddleVel) < 0.01f)
-                    {
-                        sign = (rand() % 2 == 0) ? 1 : -1;
-                    }
-                    else
-                    {
-                        sign = (paddleVel > 0) ? 1 : -1;
-                    }
-                    // 10 degree
-                    float offsetDeg = 10.0f;
-                    float offsetRad = offsetDeg * (M_PI / 180.0f);
-
-                    float vx = ball->GetVelX();
-                    float vy = ball->GetVelY();
-                    float speed = sqrt(vx * vx + vy * vy);
-                    float currentAngle = atan2(vy, vx);
-
-                    float newAngle = currentAngle + sign * offsetRad;
-
-                    ball->SetVelocity(speed * cos(newAngle), speed * sin(newAngle));
-                }
+                best = hit;
+                contact = Contact::Wall;
             }
         }
-    }
 
-    for (auto it = mBalls.begin(); it != mBalls.end();)
-    {
-        auto ballTrans = (*it)->GetTransform();
-        if (ballTrans && ballTrans->getY() > 1000)
+        const SDL_FRect path{std::min(box.x, box.x + dx), std::min(box.y, box.y + dy),
+                             box.w + std::fabs(dx), box.h + std::fabs(dy)};
+        mBrickField.Query(path, candidates);
+        for (uint32_t cell : candidates)
         {
-            it = mBalls.erase(it);
+            if (std::find(ball.hits, ball.hits + ball.hitCount, cell) != ball.hits + ball.hitCount)
+                continue;
+            if (SweepAABB(box, dx, dy, mBrickField.GetRect(cell), hit) && hit.time < best.time)
+            {
+                best = hit;
+                contact = Contact::Brick;
+                brickHit = cell;
+            }
         }
-        else
+        mBrickGrid.Query(path, candidates);
+        for (uint32_t brickIndex : candidates)
+        {
+            const auto &brick = mBricks[brickIndex];
+            if (!brick->IsActive())
+                continue;
+            const uint32_t id = brickIndex | kLegacyBrick;
+            if (std::find(ball.hits, ball.hits + ball.hitCount, id) != ball.hits + ball.hitCount)
+                continue;
+            if (SweepAABB(box, dx, dy, brick->GetTransform()->getRectangle(), hit) && hit.time < best.time)
+            {
+                best = hit;
+                contact = Contact::Brick;
+                brickHit = id;
+            }
+        }
+
+        if (paddleColl && SweepAABB(box, dx, dy, paddleRect, hit) && hit.time < best.time)
         {
-            ++it;
+            best = hit;
+            contact = Contact::Paddle;
         }
+
+        if (contact == Contact::None)
+        {
+            ball.x += dx;
+            ball.y += dy;
+            ball.remaining = 0.0f;
+            break;
+        }
+
+        const float length = std::sqrt(dx * dx + dy * dy);
+        const float travel = length > 0.0f ? std::max(0.0f, best.time - skin / length) : 0.0f;
+        ball.x += dx * travel + best.normalX * (best.depth + (best.depth > 0.0f ? skin : 0.0f));
+        ball.y += dy * travel + best.normalY * (best.depth + (best.depth > 0.0f ? skin : 0.0f));
+        ball.remaining *= 1.0f - best.time;
+        ball.bounces++;
+
+        if (best.normalX != 0.0f)
+            ball.velX = best.normalX * std::fabs(ball.velX);
+        if (best.normalY != 0.0f)
+            ball.velY = best.normalY * std::fabs(ball.velY);
+
+        const bool unbreakable = contact == Contact::Brick &&
+                                 ((brickHit & kLegacyBrick) ? mBricks[brickHit & ~kLegacyBrick]->IsUnbreakable() : mBrickField.IsUnbreakable(brickHit));
+        if (contact == Contact::Brick && !unbreakable)
+            ball.hits[ball.hitCount++] = brickHit;
+        else if (contact == Contact::Paddle && best.normalY < 0.0f)
+            ball.paddlePending = true;
     }
+}
 
-    if (mBalls.empty())
+/**
+ * @brief Hits a breakable brick, spawning a drop 30% of the time if the hit broke it.
+ *
+ * @param brick The brick's id: a BrickField cell, or an mBricks index with kLegacyBrick set.
+ */
+void Scene::BreakBrick(uint32_t brick)
+{
+    if (brick & kLegacyBrick)
+    {
+        const uint32_t index = brick & ~kLegacyBrick;
+        if (!mBricks[index]->IsActive())
+            return;
+        mBricks[index]->SetActive(false);
+        mBrickGrid.Remove(index);
+        --mLegacyBricksLeft;
+    }
+    else if (!mBrickField.Hit(brick))
+    {
+        return;
+    }
+    const SDL_FRect rect = GetBrickRect(brick);
+    mBrickLayer.MarkDirty(rect);
+    ++mBricksBroken;
+    mScore += kBrickPoints;
+    // 30%
+    if (mRandom.NextBelow(100) < 30)
     {
-        SDL_ShowSimpleMessageBox(SDL_MESSAGEBOX_INFORMATION, "GAME OVER", "GAME OVER! You Failed!", nullptr);
-        SDL_Quit();
-        exit(0);
+        SpawnDrop(rect.x, rect.y);
     }
+}
+
+/**
+ * @brief Returns whether a brick is still standing.
+ *
+ * @param brick The brick's id: a BrickField cell, or an mBricks index with kLegacyBrick set.
+ * @return bool False once the brick is broken.
+ */
+bool Scene::IsBrickAlive(uint32_t brick) const
+{
+    if (brick & kLegacyBrick)
+        return mBricks[brick & ~kLegacyBrick]->IsActive();
+    return mBrickField.IsAlive(brick);
+}
+
+/**
+ * @brief Returns a brick's rectangle.
+ *
+ * @param brick The brick's id: a BrickField cell, or an mBricks index with kLegacyBrick set.
+ * @return SDL_FRect The rectangle.
+ */
+SDL_FRect Scene::GetBrickRect(uint32_t brick) const
+{
+    if (brick & kLegacyBrick)
+        return mBrickStorage.GetRect(brick & ~kLegacyBrick);
+    return mBrickField.GetRect(brick);
+}
 
-    bool allCleared = true;
-    for (auto &brick : mBricks)
+/**
+ * @brief Tilts a ball bounced off the paddle's top face by 10 degrees.
+ *
+ * The tilt follows the paddle's motion, or a random side when the paddle is still.
+ *
+ * @param velX The ball's horizontal velocity, updated in place.
+ * @param velY The ball's vertical velocity, updated in place.
+ */
+void Scene::DeflectOffPaddle(float &velX, float &velY)
+{
+    float paddleVel = mPlayerPaddle->GetInstantaneousVelocity();
+    int sign = 0;
+    if (fabs(paddleVel) < 0.01f)
     {
-        if (brick->IsActive() && !brick->IsUnbreakable())
-        {
-            allCleared = false;
-            break;
-        }
+        sign = (mRandom.NextBelow(2) == 0) ? 1 : -1;
     }
-    if (allCleared)
+    else
     {
-        mBalls.clear();
-        SetSceneStatus(false);
+        sign = (paddleVel > 0) ? 1 : -1;
     }
+    // 10 degree
+    float offsetDeg = 10.0f;
+    float offsetRad = offsetDeg * (M_PI / 180.0f);
+
+    float speed = sqrt(velX * velX + velY * velY);
+    float currentAngle = atan2(velY, velX);
+
+    float newAngle = currentAngle + sign * offsetRad;
+
+    velX = speed * cos(newAngle);
+    velY = speed * sin(newAngle);
 }
 
 /**
  * @brief Renders the scene.
  *
- * Renders the paddle, balls, bricks, and drops.
+ * Queues the paddle, balls, bricks, and drops, each kind as one sweep over its
+ * ArchetypeStorage, then flushes the queue so sprites sharing a texture go out in one
+ * SDL_RenderGeometry call. Bricks never move, so they are drawn once into a StaticLayer
+ * texture, patched only where bricks broke, and queued as a single sprite; renderers
+ * without render targets (or SetStaticBrickLayer(false)) queue every active brick instead.
+ * Debug collision outlines are drawn last, on top of every sprite, except the bricks',
+ * which are baked into the static layer. A null renderer is the headless backend and
+ * draws nothing.
  *
- * @param renderer The SDL_Renderer used for drawing.
+ * @param renderer The SDL_Renderer used for drawing, or nullptr when running headless.
+ * @param alpha Interpolation factor between the state saved by SaveRenderState() (0) and
+ * the current state (1).
  */
-void Scene::Render(SDL_Renderer *renderer)
+void Scene::Render(SDL_Renderer *renderer, float alpha)
 {
-    if (mPlayerPaddle)
-        mPlayerPaddle->Render(renderer);
-    for (auto &ball : mBalls)
+    if (!renderer)
+        return;
+    PROFILE_ZONE("Scene::Render");
+
+    enum Layer : uint8_t
+    {
+        PaddleLayer,
+        BallLayer,
+        BrickLayer,
+        DropLayer,
+        DebugLayer
+    };
+
+    SDL_Texture *bricks = mUseBrickLayer ? mBrickLayer.Update(renderer, mBrickField, mBrickStorage, mBrickGrid) : nullptr;
+
+    mRenderQueue.Clear();
+    mPaddleStorage.Render(mRenderQueue, PaddleLayer, DebugLayer, alpha);
+    mBallStorage.Render(mRenderQueue, BallLayer, DebugLayer, alpha);
+    if (bricks)
+        mRenderQueue.AddSprite(BrickLayer, bricks, SDL_FRect{0.0f, 0.0f, static_cast<float>(StaticLayer::kWidth), static_cast<float>(StaticLayer::kHeight)});
+    else
+    {
+        mBrickField.Render(mRenderQueue, BrickLayer, DebugLayer);
+        mBrickStorage.Render(mRenderQueue, BrickLayer, DebugLayer, alpha);
+    }
+    mDropStorage.Render(mRenderQueue, DropLayer, DebugLayer, alpha);
+    mRenderQueue.Flush(renderer);
+}
+
+/**
+ * @brief Turns the cached static brick layer on or off, e.g. to compare both paths.
+ *
+ * Turning it off frees the layer's texture, so call it on the render thread.
+ *
+ * @param enabled True (the default) to draw bricks through the StaticLayer.
+ */
+void Scene::SetStaticBrickLayer(bool enabled)
+{
+    mUseBrickLayer = enabled;
+    if (!enabled)
+        mBrickLayer.Release();
+}
+
+/**
+ * @brief Frees the GPU resources the scene created itself (the static brick layer).
+ *
+ * Call it on the render thread before handing the scene to another thread to be destroyed,
+ * or before destroying the renderer. The next Render() recreates what it needs.
+ */
+void Scene::ReleaseRenderTargets()
+{
+    mBrickLayer.Release();
+}
+
+/**
+ * @brief Spawns a falling drop.
+ *
+ * Reuses a drop from the drop pool when one is free.
+ *
+ * @param x The drop's initial x-coordinate.
+ * @param y The drop's initial y-coordinate.
+ * @return EntityHandle The new drop's handle.
+ */
+EntityHandle Scene::SpawnDrop(float x, float y)
+{
+    std::shared_ptr<Drop> drop = mDropPool.Acquire(mRenderer, "../Assets/drop.bmp", 200.0f);
+    drop->initComponents(mDropTexture, &mDropStorage);
+    drop->GetTransform()->place(x, y);
+    drop->SetHandle(mEntities.Create(drop.get()));
+    mDrops.push_back(drop);
+    return drop->GetHandle();
+}
+
+/**
+ * @brief Hashes the simulation state: ball and drop positions and velocities, brick states,
+ * the paddle position and the scene's random generator.
+ *
+ * Two runs that stay bit-identical produce the same hash every frame, which makes it cheap to
+ * check determinism (e.g. across thread counts).
+ *
+ * @return uint64_t A 64-bit FNV-1a hash.
+ */
+uint64_t Scene::StateHash() const
+{
+    uint64_t hash = 14695981039346656037ull;
+    auto mix = [&hash](const void *data, size_t size)
+    {
+        const unsigned char *bytes = static_cast<const unsigned char *>(data);
+        for (size_t i = 0; i < size; ++i)
+        {
+            hash ^= bytes[i];
+            hash *= 1099511628211ull;
+        }
+    };
+    auto mixFloats = [&mix](const std::vector<float> &values)
+    { mix(values.data(), values.size() * sizeof(float)); };
+
+    mixFloats(mBallStorage.mX);
+    mixFloats(mBallStorage.mY);
+    mixFloats(mBallStorage.mVelX);
+    mixFloats(mBallStorage.mVelY);
+    mixFloats(mDropStorage.mX);
+    mixFloats(mDropStorage.mY);
+    mixFloats(mPaddleStorage.mX);
+    // One byte per brick, field cells then Brick entities, as WriteBrickMask() orders them.
+    for (uint32_t cell = 0; cell < mBrickField.GetCellCount(); ++cell)
     {
-        ball->Render(renderer);
+        if (mBrickField.IsPresent(cell))
+        {
+            const uint8_t alive = mBrickField.IsAlive(cell);
+            mix(&alive, 1);
+        }
     }
-    for (auto &brick : mBricks)
+    mix(mBrickStorage.mActive.data(), mBrickStorage.mActive.size());
+    const uint64_t random = mRandom.GetState();
+    mix(&random, sizeof(random));
+    return hash;
+}
+
+/**
+ * @brief Spawns a ball.
+ *
+ * Reuses a ball from the ball pool when one is free.
+ *
+ * @param x The ball's initial x-coordinate.
+ * @param y The ball's initial y-coordinate.
+ * @param velX The ball's horizontal velocity.
+ * @param velY The ball's vertical velocity.
+ * @return EntityHandle The new ball's handle.
+ */
+EntityHandle Scene::SpawnBall(float x, float y, float velX, float velY)
+{
+    std::shared_ptr<Ball> ball = mBallPool.Acquire(mRenderer, "../Assets/ball.bmp", 250.0f);
+    ball->initComponents(mBallTexture, &mBallStorage);
+    ball->GetTransform()->place(x, y);
+    ball->SetVelocity(velX, velY);
+    ball->SetHandle(mEntities.Create(ball.get()));
+    mBalls.push_back(ball);
+    return ball->GetHandle();
+}
+
+/**
+ * @brief Destroys a drop, returning it to the drop pool and freeing its storage row.
+ *
+ * Stale handles and handles of other kinds of entity are ignored.
+ *
+ * @param handle The drop's handle.
+ */
+void Scene::DestroyDrop(EntityHandle handle)
+{
+    GameEntity *drop = mEntities.Get(handle);
+    if (!drop)
+        return;
+    const size_t row = drop->StorageRow();
+    if (row < mDrops.size() && mDrops[row].get() == drop)
+        RemoveDrop(row);
+}
+
+/**
+ * @brief Removes a ball and returns it to the ball pool.
+ *
+ * Swap-and-pop: the last ball takes the removed one's place in mBalls, exactly as its
+ * storage row takes the removed row, so mBalls[i] keeps owning row i.
+ *
+ * @param row The ball's storage row, which is also its index in mBalls.
+ */
+void Scene::RemoveBall(size_t row)
+{
+    std::shared_ptr<Ball> ball = std::move(mBalls[row]);
+    mEntities.Destroy(ball->GetHandle());
+    mBallPool.Release(std::move(ball));
+    if (row != mBalls.size() - 1)
+        mBalls[row] = std::move(mBalls.back());
+    mBalls.pop_back();
+}
+
+/**
+ * @brief Removes a drop and returns it to the drop pool.
+ *
+ * Swap-and-pop, like RemoveBall(), so mDrops[i] keeps owning drop row i.
+ *
+ * @param row The drop's storage row, which is also its index in mDrops.
+ */
+void Scene::RemoveDrop(size_t row)
+{
+    std::shared_ptr<Drop> drop = std::move(mDrops[row]);
+    mEntities.Destroy(drop->GetHandle());
+    mDropPool.Release(std::move(drop));
+    if (row != mDrops.size() - 1)
+        mDrops[row] = std::move(mDrops.back());
+    mDrops.pop_back();
+}
+
+/**
+ * @brief Prepares the ball and drop pools and storage for a number of live balls and drops.
+ *
+ * Spawning up to that many then allocates nothing, so the first ball-multiplication event
+ * of a level costs no more than later ones.
+ *
+ * @param balls The number of balls to prepare for.
+ * @param drops The number of drops to prepare for.
+ */
+void Scene::ReserveSpawns(size_t balls, size_t drops)
+{
+    mBallPool.Reserve(balls > mBalls.size() ? balls - mBalls.size() : 0, mRenderer, "../Assets/ball.bmp", 250.0f);
+    mDropPool.Reserve(drops > mDrops.size() ? drops - mDrops.size() : 0, mRenderer, "../Assets/drop.bmp", 200.0f);
+    mBalls.reserve(balls);
+    mDrops.reserve(drops);
+    mBallStorage.Reserve(balls);
+    mDropStorage.Reserve(drops);
+    mBallSweeps.reserve(balls);
+    mDropOverlaps.reserve(drops);
+    mEntities.Reserve(1 + mBricks.size() + balls + drops);
+}
+
+/**
+ * @brief Resolves an entity handle.
+ *
+ * @param handle The handle to resolve.
+ * @return GameEntity* The entity, or nullptr if it has been destroyed.
+ */
+GameEntity *Scene::GetEntity(EntityHandle handle) const
+{
+    return mEntities.Get(handle);
+}
+
+/**
+ * @brief Returns the number of live entities in the scene.
+ *
+ * @return size_t The paddle, balls, bricks and drops currently alive.
+ */
+size_t Scene::GetEntityCount() const
+{
+    return mEntities.Size();
+}
+
+/**
+ * @brief Writes which bricks are still standing as a bitmask.
+ *
+ * Bit b of words[b / 64] (counting from the least significant bit) is set while brick b is
+ * active. Bricks are numbered BrickField cells first, row by row, then Brick entities in
+ * scene file order; for a scene laid out row by row, as the brick directives write it, that
+ * is scene file order. Unbreakable bricks are always set.
+ *
+ * @param words Receives (GetBrickCount() + 63) / 64 words.
+ */
+void Scene::WriteBrickMask(uint64_t *words) const
+{
+    std::fill(words, words + (GetBrickCount() + 63) / 64, 0);
+    size_t bit = 0;
+    for (uint32_t cell = 0; cell < mBrickField.GetCellCount(); ++cell)
     {
-        brick->Render(renderer);
+        if (!mBrickField.IsPresent(cell))
+            continue;
+        words[bit / 64] |= static_cast<uint64_t>(mBrickField.IsAlive(cell)) << (bit % 64);
+        ++bit;
     }
-    for (auto &drop : mDrops)
+    for (const auto &brick : mBricks)
     {
-        drop->Render(renderer);
+        words[bit / 64] |= static_cast<uint64_t>(brick->IsActive()) << (bit % 64);
+        ++bit;
     }
 }
 
+/**
+ * @brief Retrieves the player paddle's position and size.
+ *
+ * @param rect Receives the paddle's rectangle.
+ * @return bool False if the scene has no paddle, leaving rect untouched.
+ */
+bool Scene::GetPaddleRect(SDL_FRect &rect) const
+{
+    if (!mPlayerPaddle)
+        return false;
+    auto paddleTrans = mPlayerPaddle->GetTransform();
+    if (!paddleTrans)
+        return false;
+    rect = paddleTrans->getRectangle();
+    return true;
+}
+
+/**
+ * @brief Returns the number and estimated size of the textures this scene uses.
+ *
+ * Textures are shared through ResourceManager, so this is independent of the entity count.
+ *
+ * @return TextureStats Distinct texture count and bytes.
+ */
+TextureStats Scene::GetTextureStats() const
+{
+    return ResourceManager::getInstance().GetStats({mPaddleTexture, mBallTexture, mBrickTexture, mUnbrickTexture, mDropTexture});
+}
+
 /**
  * @brief Shuts down the scene.
  *
@@ -437,3 +1112,13 @@ bool Scene::GetSceneStatus() const
 {
     return mSceneIsActive;
 }
+
+/**
+ * @brief Checks whether the scene ended because every ball was lost.
+ *
+ * @return true if the game is over; false otherwise.
+ */
+bool Scene::IsGameOver() const
+{
+    return mGameOver;
+}
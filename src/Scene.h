@@ -9,6 +9,35 @@
 #include "Ball.h"
 #include "Brick.h"
 #include "Drop.h"
+#include "BrickGrid.h"
+#include "ArchetypeStorage.h"
+#include "EntityRegistry.h"
+#include "ResourceManager.h"
+#include "RenderQueue.h"
+#include "JobSystem.h"
+#include "AABBBatch.h"
+#include "SceneFile.h"
+#include "Random.h"
+#include "EntityPool.h"
+#include "StaticLayer.h"
+#include "BrickField.h"
+
+/**
+ * @brief A snapshot of a scene's running totals, for end-of-level checks, a HUD or telemetry.
+ *
+ * The scene keeps every total up to date as bricks break and balls and drops come and go,
+ * so taking a snapshot costs the same whatever the level size.
+ */
+struct SceneStats
+{
+    size_t bricksLeft = 0;     // breakable bricks not yet broken; the level is cleared at 0
+    size_t balls = 0;          // balls in play
+    size_t drops = 0;          // drops falling
+    uint32_t bricksBroken = 0; // since the scene was loaded, as are the totals below
+    uint32_t dropsCaught = 0;
+    uint32_t ballsLost = 0;
+    uint64_t score = 0;
+};
 
 /**
  * @brief The Scene class encapsulates a game scene.
@@ -16,6 +45,13 @@
  * A Scene manages game entities such as the player paddle, balls, bricks, and drops.
  * It provides methods for loading the scene data from a file, processing input,
  * updating all entities, rendering the scene, and determining the scene state.
+ *
+ * Bricks live in a BrickField, a compact lattice with no entity per brick; only bricks
+ * off its lattice are kept as Brick entities (see CreateEntities()). Brick ids carry
+ * kLegacyBrick for those, and are BrickField cells otherwise.
+ *
+ * A Scene loaded with a null SDL_Renderer runs headless: entities keep their sizes
+ * but own no GPU textures, and Render() is a no-op.
  */
 class Scene
 {
@@ -23,22 +59,255 @@ public:
     Scene();
 
     void LoadFromFile(const std::string &sceneFile, SDL_Renderer *renderer);
+    void Load(const SceneView &records, SDL_Renderer *renderer);
+    void AttachRenderer(SDL_Renderer *renderer);
+    void ApplyBrickEdits(const SceneView &records, size_t &added, size_t &removed);
 
-    void Input(float deltaTime);
+    void SaveRenderState();
+    void Input(float deltaTime, uint8_t buttons);
     void Update(float deltaTime);
-    void Render(SDL_Renderer *renderer);
+    void Render(SDL_Renderer *renderer, float alpha = 1.0f);
+    void SetStaticBrickLayer(bool enabled);
+
+    /**
+     * @brief Chooses whether the next Load() puts bricks in the BrickField or makes every
+     * brick an entity, e.g. to compare both.
+     *
+     * @param enabled True (the default) to use the BrickField.
+     */
+    void SetBrickField(bool enabled) { mUseBrickField = enabled; }
+    void ReleaseRenderTargets();
+
+    /**
+     * @brief Makes the next Render() redraw cached layers from scratch, e.g. after the
+     * renderer reported SDL_RENDER_TARGETS_RESET.
+     */
+    void InvalidateRenderTargets() { mBrickLayer.Invalidate(); }
+
+    /**
+     * @brief Returns the number of bricks the last Render() redrew into the static brick layer.
+     *
+     * @return size_t All active bricks after a rebuild, the neighbours of newly broken bricks otherwise.
+     */
+    size_t GetBrickLayerRedraws() const { return mBrickLayer.GetRedrawnRows(); }
     void SceneShutDown();
     void SetSceneStatus(bool active);
     bool GetSceneStatus() const;
+    bool IsGameOver() const;
+
+    /**
+     * @brief Lets Update() spread ball movement and the ball-brick narrow phase over a job system.
+     *
+     * Results are identical with or without one, for any thread count.
+     *
+     * @param jobs The job system, or nullptr to run single-threaded. It must outlive its use here.
+     */
+    void SetJobSystem(JobSystem *jobs) { mJobs = jobs; }
+
+    /**
+     * @brief Restarts the scene's random generator, which decides drop spawns and paddle deflections.
+     *
+     * Loading a scene does not touch the generator, so callers that want reproducible runs
+     * seed every scene after loading it. A new Scene starts with seed 0.
+     *
+     * @param seed The seed; see MixSeed() to derive one per scene from a run's seed.
+     */
+    void SetSeed(uint64_t seed) { mRandom.Seed(seed); }
+
+    EntityHandle SpawnBall(float x, float y, float velX, float velY);
+    EntityHandle SpawnDrop(float x, float y);
+    void DestroyDrop(EntityHandle handle);
+    void ReserveSpawns(size_t balls, size_t drops);
+    GameEntity *GetEntity(EntityHandle handle) const;
+    size_t GetEntityCount() const;
+    TextureStats GetTextureStats() const;
+    uint64_t StateHash() const;
+
+    /**
+     * @brief Returns the number of ball contacts (walls, bricks, paddle) since the scene was created.
+     *
+     * @return uint64_t The contact count.
+     */
+    uint64_t GetCollisionCount() const { return mCollisionCount; }
+
+    /**
+     * @brief Returns the number of balls that fell off the bottom since the scene was loaded.
+     *
+     * @return uint32_t The lost ball count.
+     */
+    uint32_t GetBallsLost() const { return mBallsLost; }
+
+    /**
+     * @brief Returns the number of bricks broken since the scene was loaded.
+     *
+     * @return uint32_t The broken brick count.
+     */
+    uint32_t GetBricksBroken() const { return mBricksBroken; }
+
+    /**
+     * @brief Returns the number of bricks the scene was loaded with, broken or not,
+     * adjusted by any ApplyBrickEdits().
+     *
+     * @return size_t The brick count.
+     */
+    size_t GetBrickCount() const { return mBrickField.GetBrickCount() + mBricks.size(); }
+
+    /**
+     * @brief Returns the number of bricks kept as Brick entities rather than in the BrickField.
+     *
+     * @return size_t The legacy brick count.
+     */
+    size_t GetLegacyBrickCount() const { return mBricks.size(); }
+
+    /**
+     * @brief Returns the heap memory the BrickField uses, in bytes.
+     *
+     * @return size_t The byte count.
+     */
+    size_t GetBrickFieldBytes() const { return mBrickField.GetMemoryBytes(); }
+
+    /**
+     * @brief Returns the number of breakable bricks not yet broken.
+     *
+     * @return size_t The brick count; the scene ends as cleared when it reaches 0.
+     */
+    size_t GetBricksLeft() const { return mBrickField.GetAliveBreakable() + mLegacyBricksLeft; }
+
+    /**
+     * @brief Returns the score since the scene was loaded: 10 points per brick broken and 25
+     * per drop caught.
+     *
+     * @return uint64_t The score.
+     */
+    uint64_t GetScore() const { return mScore; }
+
+    /**
+     * @brief Returns the scene's running totals.
+     *
+     * @return SceneStats The totals as of the last change.
+     */
+    SceneStats GetStats() const
+    {
+        SceneStats stats;
+        stats.bricksLeft = GetBricksLeft();
+        stats.balls = mBalls.size();
+        stats.drops = mDrops.size();
+        stats.bricksBroken = mBricksBroken;
+        stats.dropsCaught = mDropsCaught;
+        stats.ballsLost = mBallsLost;
+        stats.score = mScore;
+        return stats;
+    }
+
+    void WriteBrickMask(uint64_t *words) const;
+
+    /**
+     * @brief Returns the balls' positions, sizes and velocities, one row per ball.
+     *
+     * Lets observers such as scripted controllers read the balls without going through
+     * their entities. Rows are in no particular order.
+     *
+     * @return const ArchetypeStorage& The ball storage.
+     */
+    const ArchetypeStorage &GetBallStorage() const { return mBallStorage; }
+
+    bool GetPaddleRect(SDL_FRect &rect) const;
+
+    /**
+     * @brief Returns how many balls and drops the scene's pools have constructed, i.e. spawns that allocated.
+     *
+     * @return size_t The constructed entity count.
+     */
+    size_t GetPooledEntityCount() const { return mBallPool.GetCreatedCount() + mDropPool.GetCreatedCount(); }
+
+    /**
+     * @brief Returns the number of draw calls the last Render() issued.
+     *
+     * @return int The draw call count.
+     */
+    int GetDrawCalls() const { return mRenderQueue.GetDrawCalls(); }
 
 private:
+    static constexpr uint32_t kNoBrick = UINT32_MAX;
+    static constexpr uint32_t kLegacyBrick = 0x80000000u; // brick id bit: the rest is an mBricks index, not a cell
+    static constexpr size_t kBallsPerJob = 256;
+    static constexpr uint8_t kMaxBounces = 8;
+    static constexpr float kOffScreenY = 1000.0f; // balls and drops below this are removed
+    static constexpr uint64_t kBrickPoints = 10; // score per brick broken
+    static constexpr uint64_t kDropPoints = 25;  // score per drop caught
+
+    /**
+     * @brief A ball's motion through one step, computed by SweepBall() and committed by MoveBalls().
+     */
+    struct BallSweep
+    {
+        float x, y, w, h;
+        float velX, velY;
+        float remaining;           // fraction of the step still to simulate
+        uint8_t bounces;           // contacts so far this step
+        uint8_t hitCount;          // breakable bricks hit and not yet broken
+        bool paddlePending;        // stopped on the paddle's top face, awaiting DeflectOffPaddle()
+        uint32_t hits[kMaxBounces];
+    };
+
+    void CreateEntities(const SceneView &records);
+    void CreateBrick(const SceneBrickRecord &record);
+    void MoveBalls(float deltaTime);
+    void StartSweep(size_t ballRow, BallSweep &sweep) const;
+    void SweepBall(BallSweep &ball, float deltaTime, std::vector<uint32_t> &candidates) const;
+    void BreakBrick(uint32_t brick);
+    bool IsBrickAlive(uint32_t brick) const;
+    SDL_FRect GetBrickRect(uint32_t brick) const;
+    void RemoveBall(size_t row);
+    void RemoveDrop(size_t row);
+    void DeflectOffPaddle(float &velX, float &velY);
+
+    // Declared before the entities so the rows outlive the entities viewing them.
+    ArchetypeStorage mPaddleStorage;
+    ArchetypeStorage mBallStorage;
+    ArchetypeStorage mBrickStorage;
+    ArchetypeStorage mDropStorage;
+    EntityRegistry mEntities;
+
+    TextureHandle mPaddleTexture;
+    TextureHandle mBallTexture;
+    TextureHandle mBrickTexture;
+    TextureHandle mUnbrickTexture;
+    TextureHandle mDropTexture;
+
+    // Released balls and drops, declared after the storage their components point into.
+    EntityPool<Ball> mBallPool;
+    EntityPool<Drop> mDropPool;
+
     std::shared_ptr<Paddle> mPlayerPaddle;
+    // mBalls[i] and mDrops[i] own row i of mBallStorage and mDropStorage: spawning appends to
+    // both, and RemoveBall()/RemoveDrop() swap-and-pop both.
     std::vector<std::shared_ptr<Ball>> mBalls;
-    std::vector<std::shared_ptr<Brick>> mBricks;
+    std::vector<std::shared_ptr<Brick>> mBricks; // only the bricks mBrickField could not hold
     std::vector<std::shared_ptr<Drop>> mDrops;
 
+    BrickField mBrickField;
+    bool mUseBrickField = true;
+    BrickGrid mBrickGrid;
+    std::vector<uint32_t> mBrickCandidates;
+    std::vector<BallSweep> mBallSweeps; // per ball row, reused every step
+    AABBBatch mDropBounds;
+    std::vector<uint32_t> mDropOverlaps;
+    uint64_t mCollisionCount = 0;
+    uint32_t mBallsLost = 0;
+    uint32_t mBricksBroken = 0;
+    uint32_t mDropsCaught = 0;
+    uint64_t mScore = 0;
+    size_t mLegacyBricksLeft = 0; // breakable Brick entities still active; the field counts its own
+    Random mRandom;
+    JobSystem *mJobs = nullptr;
+    RenderQueue mRenderQueue;
+    StaticLayer mBrickLayer; // brick storage rows are brick indices: bricks are only deactivated
+    bool mUseBrickLayer = true;
+
     SDL_Renderer *mRenderer;
     bool mSceneIsActive;
+    bool mGameOver;
 };
 
 #endif
@@ -0,0 +1,554 @@
+#include "SceneFile.h"
+#include "MappedFile.h"
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string_view>
+
+namespace
+{
+    enum class SceneKeyword
+    {
+        Unknown,
+        Paddle,
+        Ball,
+        Brick,
+        Unbrick,
+        BrickRow,
+        UnbrickRow,
+        BrickGrid,
+        UnbrickGrid,
+        BrickMask,
+        UnbrickMask
+    };
+
+    // A directive may not expand to more bricks than this, so a typo cannot exhaust memory.
+    constexpr uint64_t kMaxDirectiveBricks = 1u << 24;
+
+    /**
+     * @brief FNV-1a hash of a keyword, usable in case labels.
+     */
+    constexpr uint32_t KeywordHash(std::string_view word)
+    {
+        uint32_t hash = 2166136261u;
+        for (char c : word)
+            hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+        return hash;
+    }
+
+    /**
+     * @brief Identifies a line's keyword with one hash and at most one comparison.
+     */
+    SceneKeyword MatchKeyword(std::string_view word)
+    {
+        switch (KeywordHash(word))
+        {
+        case KeywordHash("PADDLE"):
+            return word == "PADDLE" ? SceneKeyword::Paddle : SceneKeyword::Unknown;
+        case KeywordHash("BALL"):
+            return word == "BALL" ? SceneKeyword::Ball : SceneKeyword::Unknown;
+        case KeywordHash("BRICK"):
+            return word == "BRICK" ? SceneKeyword::Brick : SceneKeyword::Unknown;
+        case KeywordHash("UNBRICK"):
+            return word == "UNBRICK" ? SceneKeyword::Unbrick : SceneKeyword::Unknown;
+        case KeywordHash("BRICKROW"):
+            return word == "BRICKROW" ? SceneKeyword::BrickRow : SceneKeyword::Unknown;
+        case KeywordHash("UNBRICKROW"):
+            return word == "UNBRICKROW" ? SceneKeyword::UnbrickRow : SceneKeyword::Unknown;
+        case KeywordHash("BRICKGRID"):
+            return word == "BRICKGRID" ? SceneKeyword::BrickGrid : SceneKeyword::Unknown;
+        case KeywordHash("UNBRICKGRID"):
+            return word == "UNBRICKGRID" ? SceneKeyword::UnbrickGrid : SceneKeyword::Unknown;
+        case KeywordHash("BRICKMASK"):
+            return word == "BRICKMASK" ? SceneKeyword::BrickMask : SceneKeyword::Unknown;
+        case KeywordHash("UNBRICKMASK"):
+            return word == "UNBRICKMASK" ? SceneKeyword::UnbrickMask : SceneKeyword::Unknown;
+        default:
+            return SceneKeyword::Unknown;
+        }
+    }
+
+    bool IsBlank(char c)
+    {
+        return c == ' ' || c == '\t' || c == '\r' || c == '\v' || c == '\f';
+    }
+
+    /**
+     * @brief The position of the parser within a text scene.
+     */
+    struct TextCursor
+    {
+        const char *pos;
+        const char *lineStart;
+        const char *lineEnd;
+        uint32_t line;
+
+        void SkipBlanks()
+        {
+            while (pos < lineEnd && IsBlank(*pos))
+                ++pos;
+        }
+
+        /**
+         * @brief Returns whether only blanks or a '#' comment are left on the line.
+         */
+        bool AtLineEnd()
+        {
+            SkipBlanks();
+            return pos == lineEnd || *pos == '#';
+        }
+
+        uint32_t Column(const char *at) const { return static_cast<uint32_t>(at - lineStart) + 1; }
+
+        const char *TokenEnd(const char *token) const
+        {
+            while (token < lineEnd && !IsBlank(*token))
+                ++token;
+            return token;
+        }
+    };
+
+    /**
+     * @brief Reports a value missing from the end of a line, quoting the line's expected form.
+     */
+    void ReportMissing(const TextCursor &cursor, const char *usage, std::vector<SceneDiagnostic> &diagnostics)
+    {
+        diagnostics.push_back(SceneDiagnostic{cursor.line, cursor.Column(cursor.pos), std::string("too few values, expected: ") + usage});
+    }
+
+    /**
+     * @brief Reads the numbers following a keyword.
+     *
+     * Each number must be followed by a blank or the end of the line. On failure, a
+     * diagnostic pointing at the offending token is added.
+     */
+    bool ReadNumbers(TextCursor &cursor, const char *usage, float *values, int count, std::vector<SceneDiagnostic> &diagnostics)
+    {
+        for (int i = 0; i < count; ++i)
+        {
+            cursor.SkipBlanks();
+            const char *token = cursor.pos;
+            if (token == cursor.lineEnd)
+            {
+                ReportMissing(cursor, usage, diagnostics);
+                return false;
+            }
+            // std::from_chars does not take the leading '+' that stream extraction accepted.
+            const char *first = (*token == '+' && token + 1 < cursor.lineEnd && token[1] != '-') ? token + 1 : token;
+            const std::from_chars_result result = std::from_chars(first, cursor.lineEnd, values[i]);
+            if (result.ec != std::errc() || (result.ptr < cursor.lineEnd && !IsBlank(*result.ptr)))
+            {
+                diagnostics.push_back(SceneDiagnostic{cursor.line, cursor.Column(token),
+                                                      (result.ec == std::errc::result_out_of_range ? "number out of range: '" : "expected a number, got '") +
+                                                          std::string(token, cursor.TokenEnd(token)) + "'"});
+                return false;
+            }
+            cursor.pos = result.ptr;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Reads an unsigned integer: a count, or a row bitmask written in decimal or as 0x hex.
+     */
+    bool ReadUnsigned(TextCursor &cursor, const char *usage, uint64_t &value, std::vector<SceneDiagnostic> &diagnostics)
+    {
+        cursor.SkipBlanks();
+        const char *token = cursor.pos;
+        if (token == cursor.lineEnd)
+        {
+            ReportMissing(cursor, usage, diagnostics);
+            return false;
+        }
+        const bool hex = cursor.lineEnd - token > 2 && token[0] == '0' && (token[1] == 'x' || token[1] == 'X');
+        const std::from_chars_result result = std::from_chars(hex ? token + 2 : token, cursor.lineEnd, value, hex ? 16 : 10);
+        if (result.ec != std::errc() || (result.ptr < cursor.lineEnd && !IsBlank(*result.ptr)))
+        {
+            diagnostics.push_back(SceneDiagnostic{cursor.line, cursor.Column(token),
+                                                  "expected an unsigned integer, got '" + std::string(token, cursor.TokenEnd(token)) + "'"});
+            return false;
+        }
+        cursor.pos = result.ptr;
+        return true;
+    }
+
+    /**
+     * @brief Makes room for more bricks, growing geometrically so many directives stay linear.
+     */
+    void ReserveBricks(SceneData &data, uint64_t more)
+    {
+        const size_t needed = data.bricks.size() + static_cast<size_t>(more);
+        if (needed > data.bricks.capacity())
+            data.bricks.reserve(std::max(needed, data.bricks.capacity() * 2));
+    }
+
+    /**
+     * @brief Appends a cols x rows grid of bricks, row by row, each row left to right.
+     */
+    void ExpandBrickGrid(SceneData &data, float x0, float y0, float dx, float dy, uint64_t cols, uint64_t rows, uint32_t unbreakable)
+    {
+        ReserveBricks(data, cols * rows);
+        for (uint64_t row = 0; row < rows; ++row)
+        {
+            const float y = y0 + static_cast<float>(row) * dy;
+            for (uint64_t col = 0; col < cols; ++col)
+                data.bricks.push_back(SceneBrickRecord{x0 + static_cast<float>(col) * dx, y, unbreakable});
+        }
+    }
+
+    /**
+     * @brief Parses the rest of a BRICKROW or BRICKGRID line (or their UN forms) and expands it.
+     */
+    void ParseBrickGrid(TextCursor &cursor, bool grid, uint32_t unbreakable, SceneData &data, std::vector<SceneDiagnostic> &diagnostics)
+    {
+        const char *usage = grid ? (unbreakable ? "UNBRICKGRID x0 y0 dx dy cols rows" : "BRICKGRID x0 y0 dx dy cols rows")
+                                 : (unbreakable ? "UNBRICKROW x0 y dx count" : "BRICKROW x0 y dx count");
+        float values[4] = {0.0f, 0.0f, 0.0f, 0.0f};
+        uint64_t cols = 0, rows = 1;
+        if (!ReadNumbers(cursor, usage, values, grid ? 4 : 3, diagnostics) || !ReadUnsigned(cursor, usage, cols, diagnostics) ||
+            (grid && !ReadUnsigned(cursor, usage, rows, diagnostics)))
+            return;
+        if (cols > kMaxDirectiveBricks || rows > kMaxDirectiveBricks || cols * rows > kMaxDirectiveBricks)
+        {
+            diagnostics.push_back(SceneDiagnostic{cursor.line, 1, "directive expands to more than " + std::to_string(kMaxDirectiveBricks) + " bricks"});
+            return;
+        }
+        if (grid)
+            ExpandBrickGrid(data, values[0], values[1], values[2], values[3], cols, rows, unbreakable);
+        else
+            ExpandBrickGrid(data, values[0], values[1], values[2], 0.0f, cols, 1, unbreakable);
+    }
+
+    /**
+     * @brief Parses the rest of a BRICKMASK or UNBRICKMASK line and expands it.
+     *
+     * Every mask after the pitch is one row, top to bottom; bit c (least significant first)
+     * places a brick in column c.
+     */
+    void ParseBrickMask(TextCursor &cursor, uint32_t unbreakable, SceneData &data, std::vector<SceneDiagnostic> &diagnostics)
+    {
+        const char *usage = unbreakable ? "UNBRICKMASK x0 y0 dx dy mask..." : "BRICKMASK x0 y0 dx dy mask...";
+        float values[4];
+        if (!ReadNumbers(cursor, usage, values, 4, diagnostics))
+            return;
+        if (cursor.AtLineEnd())
+        {
+            ReportMissing(cursor, usage, diagnostics);
+            return;
+        }
+        for (uint32_t row = 0; !cursor.AtLineEnd(); ++row)
+        {
+            uint64_t mask = 0;
+            if (!ReadUnsigned(cursor, usage, mask, diagnostics))
+                return;
+            const float y = values[1] + static_cast<float>(row) * values[3];
+            ReserveBricks(data, 64);
+            for (int col = 0; col < 64; ++col)
+            {
+                if ((mask >> col) & 1)
+                    data.bricks.push_back(SceneBrickRecord{values[0] + static_cast<float>(col) * values[2], y, unbreakable});
+            }
+        }
+    }
+}
+
+/**
+ * @brief Parses a text scene held in memory into records.
+ *
+ * Each line holds one entity or one brick directive; blank lines and lines starting with
+ * '#' are skipped:
+ *  - PADDLE x y
+ *  - BALL x y vX vY
+ *  - BRICK x y
+ *  - UNBRICK x y
+ *  - BRICKROW x0 y dx count: count bricks at x0, x0 + dx, ... on row y.
+ *  - BRICKGRID x0 y0 dx dy cols rows: rows such rows of cols bricks, dy apart.
+ *  - BRICKMASK x0 y0 dx dy mask...: one row per mask, dy apart; bit c of a mask (least
+ *    significant first, decimal or 0x hex) places a brick in column c, at x0 + c * dx.
+ *  - UNBRICKROW, UNBRICKGRID and UNBRICKMASK do the same with unbreakable bricks.
+ * Directives expand in place to bricks in row order, left to right, as if each brick had
+ * its own line. Malformed lines and unknown entity types are skipped and described in
+ * diagnostics.
+ *
+ * The buffer is scanned once, in place: keywords are matched by hash and numbers read with
+ * std::from_chars, so a well-formed scene allocates nothing beyond the record arrays, which
+ * are reserved up front from the file's line count and grown as directives need.
+ *
+ * @param text The scene's bytes, e.g. a MappedFile; need not be null-terminated.
+ * @param size The number of bytes.
+ * @param data Receives the records, replacing its contents.
+ * @param diagnostics Receives one entry per problem found, appended.
+ * @return bool True if no problem was found.
+ */
+bool ParseSceneText(const char *text, size_t size, SceneData &data, std::vector<SceneDiagnostic> &diagnostics)
+{
+    data.paddles.clear();
+    data.balls.clear();
+    data.bricks.clear();
+    const char *const end = text + size;
+    data.bricks.reserve(static_cast<size_t>(std::count(text, end, '\n')) + 1);
+    const size_t problemsBefore = diagnostics.size();
+
+    TextCursor cursor{text, text, text, 0};
+    for (const char *next = text; next < end; next = cursor.lineEnd + 1)
+    {
+        cursor.lineStart = next;
+        cursor.pos = next;
+        const void *newline = std::memchr(next, '\n', static_cast<size_t>(end - next));
+        cursor.lineEnd = newline ? static_cast<const char *>(newline) : end;
+        ++cursor.line;
+
+        cursor.SkipBlanks();
+        if (cursor.pos == cursor.lineEnd || *cursor.pos == '#')
+            continue;
+        const char *keywordStart = cursor.pos;
+        cursor.pos = cursor.TokenEnd(keywordStart);
+        const std::string_view keyword(keywordStart, static_cast<size_t>(cursor.pos - keywordStart));
+
+        float values[4];
+        const SceneKeyword kind = MatchKeyword(keyword);
+        switch (kind)
+        {
+        case SceneKeyword::Paddle:
+            if (ReadNumbers(cursor, "PADDLE x y", values, 2, diagnostics))
+                data.paddles.push_back(ScenePaddleRecord{values[0], values[1]});
+            break;
+        case SceneKeyword::Ball:
+            if (ReadNumbers(cursor, "BALL x y vX vY", values, 4, diagnostics))
+                data.balls.push_back(SceneBallRecord{values[0], values[1], values[2], values[3]});
+            break;
+        case SceneKeyword::Brick:
+        case SceneKeyword::Unbrick:
+            if (ReadNumbers(cursor, kind == SceneKeyword::Unbrick ? "UNBRICK x y" : "BRICK x y", values, 2, diagnostics))
+                data.bricks.push_back(SceneBrickRecord{values[0], values[1], kind == SceneKeyword::Unbrick ? 1u : 0u});
+            break;
+        case SceneKeyword::BrickRow:
+        case SceneKeyword::UnbrickRow:
+            ParseBrickGrid(cursor, false, kind == SceneKeyword::UnbrickRow ? 1u : 0u, data, diagnostics);
+            break;
+        case SceneKeyword::BrickGrid:
+        case SceneKeyword::UnbrickGrid:
+            ParseBrickGrid(cursor, true, kind == SceneKeyword::UnbrickGrid ? 1u : 0u, data, diagnostics);
+            break;
+        case SceneKeyword::BrickMask:
+        case SceneKeyword::UnbrickMask:
+            ParseBrickMask(cursor, kind == SceneKeyword::UnbrickMask ? 1u : 0u, data, diagnostics);
+            break;
+        case SceneKeyword::Unknown:
+            diagnostics.push_back(SceneDiagnostic{cursor.line, cursor.Column(keywordStart), "unknown entity type '" + std::string(keyword) + "'"});
+            break;
+        }
+    }
+    return diagnostics.size() == problemsBefore;
+}
+
+/**
+ * @brief Prints a text scene's diagnostics to std::cerr as path:line:column: message.
+ *
+ * At most 20 are printed, followed by the number left out.
+ *
+ * @param path The scene file the diagnostics refer to.
+ * @param diagnostics The problems found by ParseSceneText().
+ */
+void ReportSceneDiagnostics(const std::string &path, const std::vector<SceneDiagnostic> &diagnostics)
+{
+    const size_t kMaxReported = 20;
+    for (size_t i = 0; i < diagnostics.size() && i < kMaxReported; ++i)
+        std::cerr << path << ":" << diagnostics[i].line << ":" << diagnostics[i].column << ": " << diagnostics[i].message << "\n";
+    if (diagnostics.size() > kMaxReported)
+        std::cerr << path << ": " << diagnostics.size() - kMaxReported << " more problem(s)\n";
+    if (!diagnostics.empty())
+        std::cerr.flush();
+}
+
+/**
+ * @brief Reads a text scene file into records, reporting any problems to std::cerr.
+ *
+ * The file is memory-mapped and parsed in place, see the in-memory ParseSceneText().
+ *
+ * @param path The text scene file.
+ * @param data Receives the records, replacing its contents.
+ * @return bool False if the file could not be opened.
+ */
+bool ParseSceneText(const std::string &path, SceneData &data)
+{
+    MappedFile mapped;
+    if (!mapped.Open(path))
+    {
+        data = SceneData{};
+        std::cerr << "Can't open the file: " << path << std::endl;
+        return false;
+    }
+    std::vector<SceneDiagnostic> diagnostics;
+    ParseSceneText(mapped.Data(), mapped.Size(), data, diagnostics);
+    ReportSceneDiagnostics(path, diagnostics);
+    return true;
+}
+
+/**
+ * @brief Writes records as a binary scene file (see SceneFileHeader).
+ *
+ * @param path The file to create or overwrite.
+ * @param data The records to write.
+ * @return bool False if the file could not be written.
+ */
+bool WriteSceneBinary(const std::string &path, const SceneData &data)
+{
+    SceneFileHeader header{};
+    std::memcpy(header.magic, kSceneMagic, sizeof(header.magic));
+    header.version = kSceneVersion;
+    header.paddleCount = static_cast<uint32_t>(data.paddles.size());
+    header.ballCount = static_cast<uint32_t>(data.balls.size());
+    header.brickCount = static_cast<uint32_t>(data.bricks.size());
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out.is_open())
+    {
+        std::cerr << "Can't create the file: " << path << std::endl;
+        return false;
+    }
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char *>(data.paddles.data()), data.paddles.size() * sizeof(ScenePaddleRecord));
+    out.write(reinterpret_cast<const char *>(data.balls.data()), data.balls.size() * sizeof(SceneBallRecord));
+    out.write(reinterpret_cast<const char *>(data.bricks.data()), data.bricks.size() * sizeof(SceneBrickRecord));
+    if (!out)
+    {
+        std::cerr << "Error writing the file: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+/**
+ * @brief Checks whether bytes start with the binary scene magic.
+ *
+ * @param bytes The start of the file.
+ * @param size The file size in bytes.
+ * @return bool True for a binary scene, false for anything else (such as a text scene).
+ */
+bool IsSceneBinary(const char *bytes, size_t size)
+{
+    return bytes && size >= sizeof(kSceneMagic) && std::memcmp(bytes, kSceneMagic, sizeof(kSceneMagic)) == 0;
+}
+
+/**
+ * @brief Validates a binary scene and points a view at its record arrays.
+ *
+ * Nothing is copied; the view is only valid as long as the bytes are.
+ *
+ * @param bytes The whole file, at least 4-byte aligned (as a mapping is).
+ * @param size The file size in bytes.
+ * @param view Receives the record arrays.
+ * @return bool False if the header is not a supported binary scene or the file is truncated.
+ */
+bool ReadSceneBinary(const char *bytes, size_t size, SceneView &view)
+{
+    if (!IsSceneBinary(bytes, size) || size < sizeof(SceneFileHeader))
+    {
+        std::cerr << "Not a binary scene file" << std::endl;
+        return false;
+    }
+    SceneFileHeader header;
+    std::memcpy(&header, bytes, sizeof(header));
+    if (header.version != kSceneVersion)
+    {
+        std::cerr << "Unsupported binary scene version " << header.version << std::endl;
+        return false;
+    }
+
+    const uint64_t expected = sizeof(SceneFileHeader) + uint64_t(header.paddleCount) * sizeof(ScenePaddleRecord) +
+                              uint64_t(header.ballCount) * sizeof(SceneBallRecord) +
+                              uint64_t(header.brickCount) * sizeof(SceneBrickRecord);
+    if (expected != size)
+    {
+        std::cerr << "Binary scene is " << size << " bytes, its header describes " << expected << std::endl;
+        return false;
+    }
+
+    const char *cursor = bytes + sizeof(SceneFileHeader);
+    view.paddles = reinterpret_cast<const ScenePaddleRecord *>(cursor);
+    view.paddleCount = header.paddleCount;
+    cursor += view.paddleCount * sizeof(ScenePaddleRecord);
+    view.balls = reinterpret_cast<const SceneBallRecord *>(cursor);
+    view.ballCount = header.ballCount;
+    cursor += view.ballCount * sizeof(SceneBallRecord);
+    view.bricks = reinterpret_cast<const SceneBrickRecord *>(cursor);
+    view.brickCount = header.brickCount;
+    return true;
+}
+
+/**
+ * @brief Returns a view of owned records.
+ *
+ * @param data The records; must outlive the view.
+ * @return SceneView The view.
+ */
+SceneView ViewScene(const SceneData &data)
+{
+    SceneView view;
+    view.paddles = data.paddles.data();
+    view.paddleCount = data.paddles.size();
+    view.balls = data.balls.data();
+    view.ballCount = data.balls.size();
+    view.bricks = data.bricks.data();
+    view.brickCount = data.bricks.size();
+    return view;
+}
+
+/**
+ * @brief Reads a text or binary scene file into owned records.
+ *
+ * For callers that keep a scene's records around, such as BatchRunner replaying one level
+ * many times; Scene::LoadFromFile() uses a binary file's records in place instead.
+ *
+ * @param path The scene file.
+ * @param data Receives the records.
+ * @return bool True on success.
+ */
+bool LoadSceneData(const std::string &path, SceneData &data)
+{
+    MappedFile mapped;
+    if (!mapped.Open(path))
+    {
+        data = SceneData{};
+        std::cerr << "Can't open the file: " << path << std::endl;
+        return false;
+    }
+    if (!IsSceneBinary(mapped.Data(), mapped.Size()))
+    {
+        std::vector<SceneDiagnostic> diagnostics;
+        ParseSceneText(mapped.Data(), mapped.Size(), data, diagnostics);
+        ReportSceneDiagnostics(path, diagnostics);
+        return true;
+    }
+
+    SceneView view;
+    if (!ReadSceneBinary(mapped.Data(), mapped.Size(), view))
+    {
+        std::cerr << "Can't load the file: " << path << std::endl;
+        return false;
+    }
+    data.paddles.assign(view.paddles, view.paddles + view.paddleCount);
+    data.balls.assign(view.balls, view.balls + view.ballCount);
+    data.bricks.assign(view.bricks, view.bricks + view.brickCount);
+    return true;
+}
+
+/**
+ * @brief Converts a text scene file into a binary one.
+ *
+ * @param textPath The text scene to read.
+ * @param binaryPath The binary scene to write.
+ * @return bool True on success.
+ */
+bool ConvertScene(const std::string &textPath, const std::string &binaryPath)
+{
+    SceneData data;
+    if (!ParseSceneText(textPath, data) || !WriteSceneBinary(binaryPath, data))
+        return false;
+    std::cout << "Converted " << textPath << " to " << binaryPath << ": " << data.paddles.size() << " paddle(s), "
+              << data.balls.size() << " ball(s), " << data.bricks.size() << " brick(s)" << std::endl;
+    return true;
+}
@@ -0,0 +1,106 @@
+#ifndef SCENEFILE_H
+#define SCENEFILE_H
+
+#include <cstdint>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @brief A PADDLE record: the paddle's position.
+ */
+struct ScenePaddleRecord
+{
+    float x, y;
+};
+
+/**
+ * @brief A BALL record: the ball's position and velocity.
+ */
+struct SceneBallRecord
+{
+    float x, y;
+    float velX, velY;
+};
+
+/**
+ * @brief A BRICK or UNBRICK record: the brick's position and whether it is unbreakable.
+ *
+ * Both kinds share one array so bricks keep their file order.
+ */
+struct SceneBrickRecord
+{
+    float x, y;
+    uint32_t unbreakable;
+};
+
+/**
+ * @brief The header of a binary scene file.
+ *
+ * A binary scene is this header followed by paddleCount paddle records, ballCount ball
+ * records and brickCount brick records, tightly packed in that order. All values are
+ * little-endian and every record is a multiple of 4 bytes, so the arrays can be used in
+ * place from a memory-mapped file.
+ */
+struct SceneFileHeader
+{
+    char magic[4]; // kSceneMagic
+    uint32_t version;
+    uint32_t paddleCount;
+    uint32_t ballCount;
+    uint32_t brickCount;
+    uint32_t reserved;
+};
+
+static_assert(sizeof(ScenePaddleRecord) == 8, "binary scene records must be packed");
+static_assert(sizeof(SceneBallRecord) == 16, "binary scene records must be packed");
+static_assert(sizeof(SceneBrickRecord) == 12, "binary scene records must be packed");
+static_assert(sizeof(SceneFileHeader) == 24, "binary scene header must be packed");
+
+constexpr char kSceneMagic[4] = {'B', 'R', 'K', 'S'};
+constexpr uint32_t kSceneVersion = 1;
+
+/**
+ * @brief The entity records of a scene, owned.
+ */
+struct SceneData
+{
+    std::vector<ScenePaddleRecord> paddles;
+    std::vector<SceneBallRecord> balls;
+    std::vector<SceneBrickRecord> bricks;
+};
+
+/**
+ * @brief The entity records of a scene, viewed in place (in a SceneData or a mapped file).
+ */
+struct SceneView
+{
+    const ScenePaddleRecord *paddles = nullptr;
+    size_t paddleCount = 0;
+    const SceneBallRecord *balls = nullptr;
+    size_t ballCount = 0;
+    const SceneBrickRecord *bricks = nullptr;
+    size_t brickCount = 0;
+};
+
+/**
+ * @brief A problem found while parsing a text scene.
+ */
+struct SceneDiagnostic
+{
+    uint32_t line;   // 1-based
+    uint32_t column; // 1-based, in bytes
+    std::string message;
+};
+
+bool ParseSceneText(const char *text, size_t size, SceneData &data, std::vector<SceneDiagnostic> &diagnostics);
+bool ParseSceneText(const std::string &path, SceneData &data);
+void ReportSceneDiagnostics(const std::string &path, const std::vector<SceneDiagnostic> &diagnostics);
+bool WriteSceneBinary(const std::string &path, const SceneData &data);
+bool IsSceneBinary(const char *bytes, size_t size);
+bool ReadSceneBinary(const char *bytes, size_t size, SceneView &view);
+SceneView ViewScene(const SceneData &data);
+bool LoadSceneData(const std::string &path, SceneData &data);
+bool ConvertScene(const std::string &textPath, const std::string &binaryPath);
+
+#endif
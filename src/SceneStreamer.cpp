@@ -0,0 +1,150 @@
+#include "SceneStreamer.h"
+#include "Profiler.h"
+
+/**
+ * @brief Starts the worker thread.
+ *
+ * @param jobs The job system handed to every loaded scene (see Scene::SetJobSystem), or nullptr.
+ */
+SceneStreamer::SceneStreamer(JobSystem *jobs)
+    : mJobs(jobs)
+{
+    mWorker = std::thread(&SceneStreamer::WorkerLoop, this);
+}
+
+/**
+ * @brief Stops the worker after its current load and destroys every scene not taken.
+ */
+SceneStreamer::~SceneStreamer()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStop = true;
+    }
+    mWake.notify_all();
+    mWorker.join();
+}
+
+/**
+ * @brief Queues a scene to be loaded in the background.
+ *
+ * @param sceneFile The scene file, text or binary.
+ */
+void SceneStreamer::Request(const std::string &sceneFile)
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mLoads.push_back(Load{sceneFile, nullptr});
+    }
+    mWake.notify_one();
+}
+
+/**
+ * @brief Checks whether the oldest requested scene has finished loading.
+ *
+ * @return bool True if Take() would return without waiting.
+ */
+bool SceneStreamer::IsReady() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return !mLoads.empty() && mLoads.front().scene;
+}
+
+/**
+ * @brief Hands over the oldest requested scene, waiting for its load if needed.
+ *
+ * The scene has no renderer yet; call Scene::AttachRenderer() before drawing it.
+ *
+ * @return std::unique_ptr<Scene> The loaded scene, or nullptr if nothing was requested.
+ */
+std::unique_ptr<Scene> SceneStreamer::Take()
+{
+    PROFILE_ZONE("SceneStreamer::Take");
+    std::unique_lock<std::mutex> lock(mMutex);
+    if (mLoads.empty())
+        return nullptr;
+    mLoaded.wait(lock, [this]
+                 { return mLoads.front().scene != nullptr; });
+    std::unique_ptr<Scene> scene = std::move(mLoads.front().scene);
+    mLoads.pop_front();
+    return scene;
+}
+
+/**
+ * @brief Gives a finished scene to the worker to destroy.
+ *
+ * The scene must no longer be used by the caller, and its textures stay in the cache.
+ *
+ * @param scene The scene to release.
+ */
+void SceneStreamer::Retire(std::unique_ptr<Scene> scene)
+{
+    if (!scene)
+        return;
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mRetired.push_back(std::move(scene));
+    }
+    mWake.notify_one();
+}
+
+/**
+ * @brief Destroys retired scenes and loads requested ones, in that order, until stopped.
+ *
+ * Retired scenes go first so the memory of a finished level is returned before the next
+ * one is built. The lock is released while loading or destroying.
+ */
+void SceneStreamer::WorkerLoop()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    for (;;)
+    {
+        auto pending = [this]
+        {
+            for (const Load &load : mLoads)
+            {
+                if (!load.scene)
+                    return &load;
+            }
+            return static_cast<const Load *>(nullptr);
+        };
+        mWake.wait(lock, [&]
+                   { return mStop || !mRetired.empty() || pending(); });
+        if (mStop)
+            return;
+
+        if (!mRetired.empty())
+        {
+            std::vector<std::unique_ptr<Scene>> retired;
+            retired.swap(mRetired);
+            lock.unlock();
+            {
+                PROFILE_ZONE("SceneStreamer::Release");
+                retired.clear();
+            }
+            lock.lock();
+            continue;
+        }
+
+        // Deque elements are not moved by push_back or pop_front of other elements, and the
+        // front is only popped once its scene is set, so the path stays valid unlocked.
+        const std::string &path = pending()->path;
+        lock.unlock();
+        std::unique_ptr<Scene> scene = std::make_unique<Scene>();
+        {
+            PROFILE_ZONE("SceneStreamer::Load");
+            scene->SetJobSystem(mJobs);
+            scene->LoadFromFile(path, nullptr);
+        }
+        lock.lock();
+        for (Load &load : mLoads)
+        {
+            if (!load.scene)
+            {
+                load.scene = std::move(scene);
+                break;
+            }
+        }
+        mLoaded.notify_all();
+    }
+}
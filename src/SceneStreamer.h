@@ -0,0 +1,55 @@
+#ifndef SCENESTREAMER_H
+#define SCENESTREAMER_H
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "Scene.h"
+#include "JobSystem.h"
+
+/**
+ * @brief The SceneStreamer class loads scenes on a worker thread while the current one plays.
+ *
+ * Requested scenes are loaded in request order with a null renderer: the file is parsed
+ * (or mapped), the entities are built and the BMPs decoded off the render thread. Take()
+ * hands a loaded scene over; the caller then calls Scene::AttachRenderer() on the render
+ * thread, which only uploads the decoded textures. Finished scenes given to Retire() are
+ * destroyed on the worker too, so tearing down a large level does not stall a frame.
+ */
+class SceneStreamer
+{
+public:
+    explicit SceneStreamer(JobSystem *jobs = nullptr);
+    ~SceneStreamer();
+    SceneStreamer(const SceneStreamer &) = delete;
+    SceneStreamer &operator=(const SceneStreamer &) = delete;
+
+    void Request(const std::string &sceneFile);
+    bool IsReady() const;
+    std::unique_ptr<Scene> Take();
+    void Retire(std::unique_ptr<Scene> scene);
+
+private:
+    struct Load
+    {
+        std::string path;
+        std::unique_ptr<Scene> scene; // set by the worker when the load is done
+    };
+
+    void WorkerLoop();
+
+    JobSystem *mJobs;
+    mutable std::mutex mMutex;
+    std::condition_variable mWake;   // work queued or stopping
+    std::condition_variable mLoaded; // a load finished
+    std::deque<Load> mLoads;         // in request order; the worker loads the first without a scene
+    std::vector<std::unique_ptr<Scene>> mRetired;
+    bool mStop = false;
+    std::thread mWorker;
+};
+
+#endif
@@ -0,0 +1,126 @@
+#include "StaticLayer.h"
+#include "Profiler.h"
+#include <cmath>
+
+/**
+ * @brief Destroys the layer's texture.
+ */
+StaticLayer::~StaticLayer()
+{
+    Release();
+}
+
+/**
+ * @brief Destroys the texture, if any; the next Update() creates and draws a new one.
+ *
+ * Call it on the render thread, and before the renderer that created the texture is destroyed.
+ */
+void StaticLayer::Release()
+{
+    if (mTexture)
+        SDL_DestroyTexture(mTexture);
+    mTexture = nullptr;
+    mRenderer = nullptr;
+    mValid = false;
+    mDirty.clear();
+}
+
+/**
+ * @brief Records that a region changed, e.g. because the entity drawn there was removed.
+ *
+ * Nothing is recorded while the whole layer is due to be redrawn anyway.
+ *
+ * @param rect The region, in layer (screen) coordinates.
+ */
+void StaticLayer::MarkDirty(const SDL_FRect &rect)
+{
+    if (mValid)
+        mDirty.push_back(rect);
+}
+
+/**
+ * @brief Brings the layer up to date and returns its texture.
+ *
+ * A new or invalidated layer is cleared to transparent and every unbroken brick and active
+ * row drawn into it; otherwise each dirty region is cleared and the bricks and active rows
+ * overlapping it redrawn, with drawing clipped to the region so the sprites around it are
+ * not blended twice. Collision outlines are baked into the layer with the sprites.
+ *
+ * @param renderer The renderer the layer is drawn with.
+ * @param field The bricks held as a BrickField.
+ * @param storage The static entities; their rows must match the indices in grid.
+ * @param grid The broadphase holding the rows still present.
+ * @return SDL_Texture* The layer, kWidth x kHeight, or nullptr if the renderer cannot render
+ * to textures, in which case the caller draws the bricks itself.
+ */
+SDL_Texture *StaticLayer::Update(SDL_Renderer *renderer, const BrickField &field, const ArchetypeStorage &storage, const BrickGrid &grid)
+{
+    PROFILE_ZONE("StaticLayer::Update");
+    mRedrawn = 0;
+    if (!renderer || !SDL_RenderTargetSupported(renderer))
+        return nullptr;
+    if (renderer != mRenderer)
+        Release();
+    if (!mTexture)
+    {
+        mTexture = SDL_CreateTexture(renderer, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_TARGET, kWidth, kHeight);
+        if (!mTexture)
+        {
+            SDL_Log("Failed to create the static layer texture: %s", SDL_GetError());
+            return nullptr;
+        }
+        SDL_SetTextureBlendMode(mTexture, SDL_BLENDMODE_BLEND);
+        mRenderer = renderer;
+        mValid = false;
+    }
+    if (mValid && mDirty.empty())
+        return mTexture;
+
+    SDL_Texture *previousTarget = SDL_GetRenderTarget(renderer);
+    SDL_BlendMode previousBlend;
+    SDL_GetRenderDrawBlendMode(renderer, &previousBlend);
+    SDL_SetRenderTarget(renderer, mTexture);
+    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 0);
+
+    if (!mValid)
+    {
+        SDL_RenderClear(renderer);
+        mQueue.Clear();
+        field.Render(mQueue, 0, 1);
+        storage.Render(mQueue, 0, 1);
+        mRedrawn = field.GetBrickCount() + storage.Size();
+        mQueue.Flush(renderer);
+        mValid = true;
+    }
+    else
+    {
+        for (const SDL_FRect &dirty : mDirty)
+        {
+            const int x0 = static_cast<int>(std::floor(dirty.x)), y0 = static_cast<int>(std::floor(dirty.y));
+            const int x1 = static_cast<int>(std::ceil(dirty.x + dirty.w)), y1 = static_cast<int>(std::ceil(dirty.y + dirty.h));
+            const SDL_Rect clip{x0, y0, x1 - x0, y1 - y0};
+            SDL_RenderSetClipRect(renderer, &clip);
+            SDL_SetRenderDrawBlendMode(renderer, SDL_BLENDMODE_NONE);
+            SDL_RenderFillRect(renderer, &clip);
+            SDL_SetRenderDrawBlendMode(renderer, previousBlend);
+
+            mQueue.Clear();
+            const SDL_FRect region{static_cast<float>(clip.x), static_cast<float>(clip.y), static_cast<float>(clip.w), static_cast<float>(clip.h)};
+            field.Query(region, mRows);
+            for (uint32_t cell : mRows)
+                field.RenderCell(mQueue, cell, 0, 1);
+            mRedrawn += mRows.size();
+            grid.Query(region, mRows);
+            for (uint32_t row : mRows)
+                storage.RenderRow(mQueue, row, 0, 1);
+            mRedrawn += mRows.size();
+            mQueue.Flush(renderer);
+        }
+        SDL_RenderSetClipRect(renderer, nullptr);
+    }
+    mDirty.clear();
+
+    SDL_SetRenderDrawBlendMode(renderer, previousBlend);
+    SDL_SetRenderTarget(renderer, previousTarget);
+    return mTexture;
+}
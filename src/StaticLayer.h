@@ -0,0 +1,64 @@
+#ifndef STATICLAYER_H
+#define STATICLAYER_H
+
+#include <vector>
+#include <cstdint>
+#include <SDL2/SDL.h>
+#include "ArchetypeStorage.h"
+#include "BrickField.h"
+#include "BrickGrid.h"
+#include "RenderQueue.h"
+
+/**
+ * @brief The StaticLayer class caches the sprites of entities that never move in a render-target texture.
+ *
+ * The bricks of a BrickField and the rows of an ArchetypeStorage (the Brick entities) are
+ * drawn into the texture once; after that, a frame only blits the texture, whatever the
+ * number of bricks. When a brick disappears its rectangle is marked dirty, and the next
+ * Update() clears just that region and redraws the bricks overlapping it, found through
+ * BrickField::Query() and the BrickGrid, clipped to the region.
+ *
+ * The texture belongs to the renderer that drew it: Release() it on the render thread.
+ */
+class StaticLayer
+{
+public:
+    static constexpr int kWidth = 1600;
+    static constexpr int kHeight = 1000;
+
+    StaticLayer() = default;
+    ~StaticLayer();
+    StaticLayer(const StaticLayer &) = delete;
+    StaticLayer &operator=(const StaticLayer &) = delete;
+
+    /**
+     * @brief Makes the next Update() redraw the whole layer, e.g. for a new level or lost target contents.
+     */
+    void Invalidate()
+    {
+        mValid = false;
+        mDirty.clear();
+    }
+
+    void MarkDirty(const SDL_FRect &rect);
+    SDL_Texture *Update(SDL_Renderer *renderer, const BrickField &field, const ArchetypeStorage &storage, const BrickGrid &grid);
+    void Release();
+
+    /**
+     * @brief Returns the number of bricks (field cells and rows) the last Update() redrew into the layer.
+     *
+     * @return size_t 0 when the layer was already up to date.
+     */
+    size_t GetRedrawnRows() const { return mRedrawn; }
+
+private:
+    SDL_Renderer *mRenderer = nullptr;
+    SDL_Texture *mTexture = nullptr;
+    bool mValid = false;
+    std::vector<SDL_FRect> mDirty;
+    std::vector<uint32_t> mRows;
+    RenderQueue mQueue;
+    size_t mRedrawn = 0;
+};
+
+#endif
@@ -0,0 +1,103 @@
+#include "SweptAABB.h"
+#include <cmath>
+#include <limits>
+
+/**
+ * @brief Computes when a box moving by (dx, dy) first touches a static target box.
+ *
+ * Uses the slab method on the Minkowski sum: the time of entry is the latest of the
+ * per-axis entry times and the face hit is the one of that axis. A box that already
+ * overlaps the target is reported as a hit at time 0, with the normal of the axis of least
+ * penetration and the depth needed to separate, but only if it is moving further in;
+ * a box moving out of an overlap is left alone.
+ *
+ * @param box The moving box at the start of the move.
+ * @param dx The horizontal displacement over the move.
+ * @param dy The vertical displacement over the move.
+ * @param target The static box.
+ * @param hit Receives the time of impact and the normal when the function returns true.
+ * @return bool True if the boxes touch during the move.
+ */
+bool SweepAABB(const SDL_FRect &box, float dx, float dy, const SDL_FRect &target, SweepHit &hit)
+{
+    const float infinity = std::numeric_limits<float>::infinity();
+
+    const bool overlapX = box.x < target.x + target.w && box.x + box.w > target.x;
+    const bool overlapY = box.y < target.y + target.h && box.y + box.h > target.y;
+    if (overlapX && overlapY)
+    {
+        const float pushLeft = box.x + box.w - target.x;
+        const float pushRight = target.x + target.w - box.x;
+        const float pushUp = box.y + box.h - target.y;
+        const float pushDown = target.y + target.h - box.y;
+        const float depthX = std::fmin(pushLeft, pushRight);
+        const float depthY = std::fmin(pushUp, pushDown);
+
+        SweepHit overlap;
+        overlap.time = 0.0f;
+        if (depthX < depthY)
+        {
+            overlap.normalX = pushLeft < pushRight ? -1.0f : 1.0f;
+            overlap.depth = depthX;
+        }
+        else
+        {
+            overlap.normalY = pushUp < pushDown ? -1.0f : 1.0f;
+            overlap.depth = depthY;
+        }
+        if (dx * overlap.normalX + dy * overlap.normalY >= 0.0f)
+            return false;
+        hit = overlap;
+        return true;
+    }
+
+    float entryX, exitX, entryY, exitY;
+    if (dx > 0.0f)
+    {
+        entryX = (target.x - (box.x + box.w)) / dx;
+        exitX = (target.x + target.w - box.x) / dx;
+    }
+    else if (dx < 0.0f)
+    {
+        entryX = (target.x + target.w - box.x) / dx;
+        exitX = (target.x - (box.x + box.w)) / dx;
+    }
+    else
+    {
+        if (!overlapX)
+            return false;
+        entryX = -infinity;
+        exitX = infinity;
+    }
+
+    if (dy > 0.0f)
+    {
+        entryY = (target.y - (box.y + box.h)) / dy;
+        exitY = (target.y + target.h - box.y) / dy;
+    }
+    else if (dy < 0.0f)
+    {
+        entryY = (target.y + target.h - box.y) / dy;
+        exitY = (target.y - (box.y + box.h)) / dy;
+    }
+    else
+    {
+        if (!overlapY)
+            return false;
+        entryY = -infinity;
+        exitY = infinity;
+    }
+
+    const float entry = std::fmax(entryX, entryY);
+    const float exit = std::fmin(exitX, exitY);
+    if (entry > exit || entry < 0.0f || entry >= 1.0f)
+        return false;
+
+    hit = SweepHit{};
+    hit.time = entry;
+    if (entryX > entryY)
+        hit.normalX = dx > 0.0f ? -1.0f : 1.0f;
+    else
+        hit.normalY = dy > 0.0f ? -1.0f : 1.0f;
+    return true;
+}
@@ -0,0 +1,19 @@
+#ifndef SWEPTAABB_H
+#define SWEPTAABB_H
+
+#include <SDL2/SDL.h>
+
+/**
+ * @brief Result of a swept AABB test.
+ */
+struct SweepHit
+{
+    float time = 1.0f;   ///< Fraction of the move at which the boxes first touch, 0 to 1.
+    float normalX = 0.0f; ///< Surface normal of the face hit, pointing away from the target.
+    float normalY = 0.0f;
+    float depth = 0.0f;   ///< For boxes already overlapping: distance to push out along the normal.
+};
+
+bool SweepAABB(const SDL_FRect &box, float dx, float dy, const SDL_FRect &target, SweepHit &hit);
+
+#endif
@@ -1,59 +1,45 @@
 #include "TextureComponent.h"
-#include <iostream>
 
 /**
  * @brief Constructs a new TextureComponent object.
  *
- * Attempts to load a BMP image from texturePath. On success, creates an SDL_Texture from the surface,
- * initializes the destination rectangle with the image dimensions, and frees the surface.
+ * Initializes the destination rectangle with the dimensions of the cached image.
  *
- * @param renderer The SDL_Renderer used to create the texture.
- * @param texturePath The file path to the BMP image.
+ * @param texture A handle returned by ResourceManager::LoadTexture().
  */
-TextureComponent::TextureComponent(SDL_Renderer *renderer, const char *texturePath)
+TextureComponent::TextureComponent(TextureHandle texture)
+    : mTexture(texture), mRect{0, 0, 0, 0}
 {
-    SDL_Surface *surface = SDL_LoadBMP(texturePath);
-    if (!surface)
-    {
-        std::cerr << "Failed to load image: " << texturePath << " SDL_Error: " << SDL_GetError() << std::endl;
-        mTexture = nullptr;
-        return;
-    }
-    mTexture = SDL_CreateTextureFromSurface(renderer, surface);
-    if (!mTexture)
-    {
-        std::cerr << "Failed to create texture: " << SDL_GetError() << std::endl;
-    }
-    mRect.x = 0;
-    mRect.y = 0;
-    mRect.w = static_cast<float>(surface->w);
-    mRect.h = static_cast<float>(surface->h);
-    SDL_FreeSurface(surface);
+    SetTexture(texture);
 }
 
 /**
- * @brief Destroys the TextureComponent object.
+ * @brief Switches to another cached image and resets the destination rectangle to its size.
  *
- * Frees the SDL_Texture resource if it exists.
+ * @param texture A handle returned by ResourceManager::LoadTexture().
  */
-TextureComponent::~TextureComponent()
+void TextureComponent::SetTexture(TextureHandle texture)
 {
-    if (mTexture)
-        SDL_DestroyTexture(mTexture);
+    ResourceManager &resources = ResourceManager::getInstance();
+    mTexture = texture;
+    mRect = SDL_FRect{0, 0, static_cast<float>(resources.GetWidth(texture)), static_cast<float>(resources.GetHeight(texture))};
 }
 
 /**
  * @brief Renders the texture.
  *
  * Uses SDL_RenderCopyF to draw the texture onto the renderer using the stored rectangle.
+ * Atlased textures draw only their sub-rectangle of the shared atlas.
  *
  * @param renderer The SDL_Renderer used for drawing.
  */
 void TextureComponent::Render(SDL_Renderer *renderer)
 {
-    if (mTexture)
+    SDL_Texture *texture = getTexture();
+    if (texture)
     {
-        SDL_RenderCopyF(renderer, mTexture, nullptr, &mRect);
+        SDL_Rect source = getSourceRect();
+        SDL_RenderCopyF(renderer, texture, &source, &mRect);
     }
 }
 
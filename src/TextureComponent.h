@@ -3,6 +3,7 @@
 
 #include "../include/Component.hpp"
 #include "../include/ComponentType.hpp"
+#include "ResourceManager.h"
 #include <SDL2/SDL.h>
 #include <memory>
 #include <string>
@@ -10,15 +11,20 @@
 /**
  * @brief The TextureComponent class encapsulates texture handling for a game entity.
  *
- * It loads a BMP image from a given file path using SDL_LoadBMP and creates an SDL_Texture.
- * The texture's rendering parameters are stored in an SDL_FRect. This component is used by
- * GameEntity for rendering the entity's visual appearance.
+ * It holds a TextureHandle into the shared ResourceManager cache rather than its own SDL_Texture,
+ * so any number of entities can share one texture. The texture's rendering parameters are stored in
+ * an SDL_FRect. This component is used by GameEntity for rendering the entity's visual appearance.
  */
 class TextureComponent : public Component
 {
 public:
-    TextureComponent(SDL_Renderer *renderer, const char *texturePath);
-    ~TextureComponent();
+    /**
+     * @brief The slot this component occupies in a GameEntity, known at compile time.
+     */
+    static constexpr ComponentType StaticType = ComponentType::TextureComponent;
+
+    explicit TextureComponent(TextureHandle texture);
+    void SetTexture(TextureHandle texture);
 
     virtual void Render(SDL_Renderer *renderer) override;
 
@@ -27,7 +33,7 @@ public:
      *
      * @return ComponentType Returns ComponentType::TextureComponent.
      */
-    virtual ComponentType GetType() const override { return ComponentType::TextureComponent; }
+    virtual ComponentType GetType() const override { return StaticType; }
 
     void move(float x, float y);
     float getX() const;
@@ -35,14 +41,28 @@ public:
     SDL_FRect getRectangle() const;
 
     /**
-     * @brief Retrieves the underlying SDL_Texture.
+     * @brief Retrieves the underlying SDL_Texture from the cache.
+     *
+     * @return SDL_Texture* Pointer to the SDL_Texture, or nullptr when headless.
+     */
+    SDL_Texture *getTexture() const { return ResourceManager::getInstance().GetTexture(mTexture); }
+
+    /**
+     * @brief Retrieves the region of getTexture() holding this component's image.
+     *
+     * @return SDL_Rect The source rectangle; a sub-rectangle when the texture is atlased.
+     */
+    SDL_Rect getSourceRect() const { return ResourceManager::getInstance().GetSourceRect(mTexture); }
+
+    /**
+     * @brief Retrieves the handle of the cached texture.
      *
-     * @return SDL_Texture* Pointer to the SDL_Texture.
+     * @return TextureHandle The texture handle.
      */
-    SDL_Texture *getTexture() const { return mTexture; }
+    TextureHandle getHandle() const { return mTexture; }
 
 private:
-    SDL_Texture *mTexture;
+    TextureHandle mTexture;
     SDL_FRect mRect;
 };
 
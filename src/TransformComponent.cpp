@@ -3,41 +3,52 @@
 #include <ostream>
 
 /**
- * @brief Constructs a new TransformComponent object with a zero-initialized rectangle.
- */
-TransformComponent::TransformComponent() : mRectangle{0, 0, 0, 0} {}
-
-/**
- * @brief Constructs a new TransformComponent object with specified values.
+ * @brief Constructs a new TransformComponent viewing a row of an ArchetypeStorage.
  *
- * @param x The initial x-coordinate.
- * @param y The initial y-coordinate.
- * @param w The initial width.
- * @param h The initial height.
+ * @param storage The storage holding the entity's transform data.
+ * @param handle The entity's row handle in that storage.
  */
-TransformComponent::TransformComponent(float x, float y, float w, float h) : mRectangle{x, y, w, h} {}
+TransformComponent::TransformComponent(ArchetypeStorage *storage, StorageHandle handle)
+    : mStorage(storage), mHandle(handle) {}
 
 /**
  * @brief Moves the transform to the specified position.
  *
- * Updates the internal rectangle's x and y values.
+ * Updates the x and y values in the entity's storage row.
  *
  * @param x The new x-coordinate.
  * @param y The new y-coordinate.
  */
 void TransformComponent::move(float x, float y)
 {
-    mRectangle.x = x;
-    mRectangle.y = y;
+    size_t row = Row();
+    mStorage->mX[row] = x;
+    mStorage->mY[row] = y;
     // std::cout << "Transform moved to (" << x << ", " << y << ")" << std::endl;
 }
 
+/**
+ * @brief Puts the transform at a position without interpolating from the old one.
+ *
+ * Use this for spawning and teleporting: the previous-step position is set too, so the
+ * next rendered frame does not show the entity sliding in from where it was.
+ *
+ * @param x The new x-coordinate.
+ * @param y The new y-coordinate.
+ */
+void TransformComponent::place(float x, float y)
+{
+    size_t row = Row();
+    mStorage->mX[row] = mStorage->mPrevX[row] = x;
+    mStorage->mY[row] = mStorage->mPrevY[row] = y;
+}
+
 /**
  * @brief Retrieves the transform's rectangle.
  *
  * @return SDL_FRect The rectangle representing the current position and size.
  */
-SDL_FRect TransformComponent::getRectangle()
+SDL_FRect TransformComponent::getRectangle() const
 {
-    return mRectangle;
+    return mStorage->GetRect(Row());
 }
\ No newline at end of file
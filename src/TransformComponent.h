@@ -3,81 +3,99 @@
 
 #include "../include/Component.hpp"
 #include "../include/ComponentType.hpp"
+#include "ArchetypeStorage.h"
 #include <SDL2/SDL.h>
 #include <memory>
 
 /**
  * @brief The TransformComponent class provides position and size data for a game entity.
  *
- * This component holds an SDL_FRect that represents the position (x, y) and dimensions (width, height)
- * of the entity. It is used for rendering and collision detection.
+ * This component is a view onto the entity's row in an ArchetypeStorage, which holds the position (x, y)
+ * and dimensions (width, height) of the entity. It is used for rendering and collision detection.
  */
 class TransformComponent : public Component
 {
 public:
-    TransformComponent();
-    TransformComponent(float x, float y, float w, float h);
+    /**
+     * @brief The slot this component occupies in a GameEntity, known at compile time.
+     */
+    static constexpr ComponentType StaticType = ComponentType::TransformComponent;
+
+    TransformComponent(ArchetypeStorage *storage, StorageHandle handle);
     virtual ~TransformComponent() = default;
 
+    /**
+     * @brief Points the component at another storage row, for an entity reused from an EntityPool.
+     *
+     * @param storage The storage holding the entity's data.
+     * @param handle The entity's new row handle in that storage.
+     */
+    void Bind(ArchetypeStorage *storage, StorageHandle handle)
+    {
+        mStorage = storage;
+        mHandle = handle;
+    }
+
     /**
      * @brief Sets the x-coordinate of the rectangle.
      *
      * @param x The new x-coordinate.
      */
-    void setX(float x) { mRectangle.x = x; }
+    void setX(float x) { mStorage->mX[Row()] = x; }
 
     /**
      * @brief Sets the y-coordinate of the rectangle.
      *
      * @param y The new y-coordinate.
      */
-    void setY(float y) { mRectangle.y = y; }
+    void setY(float y) { mStorage->mY[Row()] = y; }
 
     /**
      * @brief Gets the x-coordinate of the rectangle.
      *
      * @return float The current x-coordinate.
      */
-    float getX() const { return mRectangle.x; }
+    float getX() const { return mStorage->mX[Row()]; }
 
     /**
      * @brief Gets the y-coordinate of the rectangle.
      *
      * @return float The current y-coordinate.
      */
-    float getY() const { return mRectangle.y; }
+    float getY() const { return mStorage->mY[Row()]; }
 
     /**
      * @brief Sets the width of the rectangle.
      *
      * @param w The new width.
      */
-    void setW(float w) { mRectangle.w = w; }
+    void setW(float w) { mStorage->mW[Row()] = w; }
 
     /**
      * @brief Sets the height of the rectangle.
      *
      * @param h The new height.
      */
-    void setH(float h) { mRectangle.h = h; }
+    void setH(float h) { mStorage->mH[Row()] = h; }
 
     /**
      * @brief Gets the width of the rectangle.
      *
      * @return float The current width.
      */
-    float getW() const { return mRectangle.w; }
+    float getW() const { return mStorage->mW[Row()]; }
 
     /**
      * @brief Gets the height of the rectangle.
      *
      * @return float The current height.
      */
-    float getH() const { return mRectangle.h; }
+    float getH() const { return mStorage->mH[Row()]; }
 
-    SDL_FRect getRectangle();
+    SDL_FRect getRectangle() const;
 
     void move(float x, float y);
+    void place(float x, float y);
 
     virtual void Input(float deltaTime) override {}
     virtual void Update(float deltaTime) override {}
@@ -90,10 +108,16 @@ public:
      *
      * @return ComponentType Returns ComponentType::TransformComponent.
      */
-    virtual ComponentType GetType() const override { return ComponentType::TransformComponent; }
+    virtual ComponentType GetType() const override { return StaticType; }
 
 private:
-    SDL_FRect mRectangle;
+    /**
+     * @brief Returns the current dense row of the viewed entity.
+     */
+    size_t Row() const { return mStorage->Dense(mHandle); }
+
+    ArchetypeStorage *mStorage;
+    StorageHandle mHandle;
 };
 
 #endif
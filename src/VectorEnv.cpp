@@ -0,0 +1,154 @@
+#include "VectorEnv.h"
+#include "Random.h"
+#include <algorithm>
+
+/**
+ * @brief Constructs the environments' settings; call Init() before using them.
+ *
+ * @param options The scene, environment count, ball slots, episode limit, timestep and seed.
+ */
+VectorEnv::VectorEnv(const VectorEnvOptions &options) : mOptions(options)
+{
+}
+
+/**
+ * @brief Parses the scene once and creates the environments, each at the start of its first episode.
+ *
+ * @return bool False if the scene cannot be read.
+ */
+bool VectorEnv::Init()
+{
+    if (!LoadSceneData(mOptions.scene, mRecords))
+        return false;
+    mEnvs.clear();
+    mEnvs.resize(mOptions.envCount);
+    for (size_t env = 0; env < mEnvs.size(); ++env)
+    {
+        mEnvs[env].scene = std::make_unique<Scene>();
+        mEnvs[env].episode = 0;
+        ResetEnv(env);
+    }
+    return true;
+}
+
+/**
+ * @brief Writes every environment's current observation, with zero rewards and no done flags.
+ *
+ * Call it once after Init() to get the first observations; it does not restart episodes.
+ *
+ * @param buffers The caller's arrays.
+ */
+void VectorEnv::Reset(const EnvBuffers &buffers)
+{
+    for (size_t env = 0; env < mEnvs.size(); ++env)
+    {
+        Observe(env, buffers);
+        buffers.rewards[env] = 0.0f;
+        buffers.dones[env] = kEnvRunning;
+    }
+}
+
+/**
+ * @brief Advances every environment by one step.
+ *
+ * Environments are split into a few chunks per thread: one step of one scene takes
+ * about a microsecond, too little to be worth a job of its own.
+ *
+ * @param actions One InputButton mask per environment.
+ * @param buffers The caller's arrays, filled with the observations after the step.
+ * @param jobs The job system to spread the environments over.
+ */
+void VectorEnv::Step(const uint8_t *actions, const EnvBuffers &buffers, JobSystem &jobs)
+{
+    const size_t grain = std::max<size_t>(1, mEnvs.size() / (jobs.GetThreadCount() * 4));
+    jobs.ParallelFor(mEnvs.size(), grain, [&](size_t begin, size_t end)
+                     {
+                         for (size_t env = begin; env < end; ++env)
+                             StepEnv(env, actions[env], buffers);
+                     });
+}
+
+/**
+ * @brief Restarts an environment's scene for its next episode.
+ *
+ * @param env The environment index.
+ */
+void VectorEnv::ResetEnv(size_t env)
+{
+    Env &state = mEnvs[env];
+    state.scene->Load(ViewScene(mRecords), nullptr);
+    state.scene->SetSeed(MixSeed(MixSeed(mOptions.seed, env), state.episode));
+    state.steps = 0;
+}
+
+/**
+ * @brief Steps one environment, scores the step and resets the environment if its episode ended.
+ *
+ * @param env The environment index.
+ * @param action The InputButton bits held during the step.
+ * @param buffers The caller's arrays.
+ */
+void VectorEnv::StepEnv(size_t env, uint8_t action, const EnvBuffers &buffers)
+{
+    Env &state = mEnvs[env];
+    Scene &scene = *state.scene;
+    const uint32_t brokenBefore = scene.GetBricksBroken();
+    const uint32_t lostBefore = scene.GetBallsLost();
+
+    scene.Input(mOptions.dt, action);
+    scene.Update(mOptions.dt);
+    ++state.steps;
+
+    buffers.rewards[env] = static_cast<float>(scene.GetBricksBroken() - brokenBefore) -
+                           static_cast<float>(scene.GetBallsLost() - lostBefore);
+
+    uint8_t done = kEnvRunning;
+    if (scene.IsGameOver())
+        done = kEnvGameOver;
+    else if (!scene.GetSceneStatus())
+        done = kEnvCleared;
+    else if (mOptions.maxEpisodeSteps > 0 && state.steps >= mOptions.maxEpisodeSteps)
+        done = kEnvTruncated;
+    buffers.dones[env] = done;
+
+    if (done != kEnvRunning)
+    {
+        ++state.episode;
+        ResetEnv(env);
+    }
+    Observe(env, buffers);
+}
+
+/**
+ * @brief Writes one environment's observation: its balls, paddle and brick mask.
+ *
+ * Balls are copied from the scene's ball storage in row order; rows past maxBalls are
+ * counted in ballCounts but not written.
+ *
+ * @param env The environment index.
+ * @param buffers The caller's arrays.
+ */
+void VectorEnv::Observe(size_t env, const EnvBuffers &buffers) const
+{
+    const Scene &scene = *mEnvs[env].scene;
+    const ArchetypeStorage &balls = scene.GetBallStorage();
+    const size_t ballCount = balls.Size();
+    const size_t written = std::min(ballCount, mOptions.maxBalls);
+
+    float *out = buffers.balls + env * mOptions.maxBalls * 4;
+    for (size_t i = 0; i < written; ++i, out += 4)
+    {
+        out[0] = balls.mX[i];
+        out[1] = balls.mY[i];
+        out[2] = balls.mVelX[i];
+        out[3] = balls.mVelY[i];
+    }
+    std::fill(out, out + (mOptions.maxBalls - written) * 4, 0.0f);
+    buffers.ballCounts[env] = static_cast<uint32_t>(ballCount);
+
+    SDL_FRect paddle{0.0f, 0.0f, 0.0f, 0.0f};
+    scene.GetPaddleRect(paddle);
+    buffers.paddleX[env] = paddle.x;
+
+    scene.WriteBrickMask(buffers.brickMasks + env * BrickMaskWords());
+}
@@ -0,0 +1,109 @@
+#ifndef VECTORENV_H
+#define VECTORENV_H
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include "Scene.h"
+#include "SceneFile.h"
+#include "JobSystem.h"
+
+/**
+ * @brief Why an environment's episode ended on a step, as written to EnvBuffers::dones.
+ */
+enum EnvDone : uint8_t
+{
+    kEnvRunning = 0,   ///< The episode goes on.
+    kEnvGameOver = 1,  ///< Every ball was lost.
+    kEnvCleared = 2,   ///< Every breakable brick was broken.
+    kEnvTruncated = 3  ///< The episode reached the step limit.
+};
+
+/**
+ * @brief What a VectorEnv simulates.
+ */
+struct VectorEnvOptions
+{
+    std::string scene = "../Scenes/scene1.txt";
+    size_t envCount = 64;
+    size_t maxBalls = 8;            // ball slots per environment in EnvBuffers::balls
+    long maxEpisodeSteps = 100000;  // 0: no limit
+    float dt = 1.0f / 60.0f;
+    uint64_t seed = 0;
+};
+
+/**
+ * @brief Caller-owned arrays a VectorEnv writes each step's results into.
+ *
+ * Every array is indexed by environment first and must hold the sizes given below,
+ * where N is the environment count. VectorEnv never allocates or copies them.
+ */
+struct EnvBuffers
+{
+    float *balls;          // N * maxBalls * 4: x, y, velX, velY per ball slot; unused slots are zero
+    uint32_t *ballCounts;  // N: balls in play, which may exceed maxBalls
+    float *paddleX;        // N: the paddle's left edge
+    uint64_t *brickMasks;  // N * BrickMaskWords(): see Scene::WriteBrickMask()
+    float *rewards;        // N: bricks broken minus balls lost during the step
+    uint8_t *dones;        // N: EnvDone
+};
+
+/**
+ * @brief The VectorEnv class steps many independent copies of a scene in lockstep.
+ *
+ * Made for training paddle controllers: Step() takes one action (InputButton bits) per
+ * environment, advances all of them by one fixed step on a job system and writes the
+ * observations, rewards and done flags straight from the scenes' storage into the
+ * caller's EnvBuffers.
+ *
+ * An environment whose episode ends is reset within the same Step(): its done flag and
+ * reward describe the step that ended the episode, and its observation is already the
+ * first one of the next episode. Episode e of environment i is seeded with
+ * MixSeed(MixSeed(seed, i), e), so runs are reproducible for any thread count.
+ */
+class VectorEnv
+{
+public:
+    explicit VectorEnv(const VectorEnvOptions &options);
+
+    bool Init();
+    void Reset(const EnvBuffers &buffers);
+    void Step(const uint8_t *actions, const EnvBuffers &buffers, JobSystem &jobs);
+
+    /**
+     * @brief Returns the number of environments.
+     */
+    size_t GetEnvCount() const { return mEnvs.size(); }
+
+    /**
+     * @brief Returns the number of 64-bit words in one environment's brick mask.
+     */
+    size_t BrickMaskWords() const { return (mRecords.bricks.size() + 63) / 64; }
+
+    /**
+     * @brief Returns an environment's scene, e.g. to render or inspect it between steps.
+     *
+     * @param env The environment index.
+     */
+    const Scene &GetScene(size_t env) const { return *mEnvs[env].scene; }
+
+private:
+    struct Env
+    {
+        std::unique_ptr<Scene> scene;
+        uint64_t episode = 0;
+        long steps = 0;
+    };
+
+    void ResetEnv(size_t env);
+    void StepEnv(size_t env, uint8_t action, const EnvBuffers &buffers);
+    void Observe(size_t env, const EnvBuffers &buffers) const;
+
+    VectorEnvOptions mOptions;
+    SceneData mRecords;
+    std::vector<Env> mEnvs;
+};
+
+#endif